@@ -1,118 +1,2845 @@
-﻿#include <iostream>
+﻿#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "Ws2_32.lib")
+#pragma comment(lib, "Psapi.lib")
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
 #include <vector>
 #include <set>
 #include <chrono>
 #include <random>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <deque>
+#include <map>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Graph.h"
+
+// Silniki porównywane z implementacjami referencyjnymi (euler / hamiltonUtil)
+struct EulerEngine {
+    string name;
+    function<vector<int>(Graph&)> solve;
+};
+
+struct HamiltonEngine {
+    string name;
+    function<bool(Graph&, vector<int>&)> solve;
+};
+
+vector<int> referenceEuler(Graph& g) {
+    vector<int> cycle;
+    int start = 0;
+    while (start < g.n && g.adj[start].empty()) ++start;
+    g.resetUsed();
+    if (start < g.n) g.euler(start, cycle);
+    return cycle;
+}
+
+bool referenceHamilton(Graph& g, vector<int>& path) {
+    path.clear();
+    return g.hamilton(path);
+}
+
+vector<EulerEngine>& eulerEngines() {
+    static vector<EulerEngine> engines;
+    return engines;
+}
+
+vector<HamiltonEngine>& hamiltonEngines() {
+    static vector<HamiltonEngine> engines;
+    return engines;
+}
+
+// Silniki CSR dają te same wyniki co referencja, więc trafiają do testów różnicowych
+void registerEngines() {
+    eulerEngines().push_back({ "csrEuler", [](Graph& g) {
+        int start = 0;
+        while (start < g.n && g.adj[start].empty()) ++start;
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return start < g.n ? csrEuler(c.view(), start) : vector<int>();
+    } });
+    eulerEngines().push_back({ "interleavedEuler", [](Graph& g) {
+        int start = 0;
+        while (start < g.n && g.adj[start].empty()) ++start;
+        CsrGraph c = CsrGraph::fromGraph(g);
+        // dwa przejścia po tym samym grafie, żeby maszyna stanów faktycznie się przeplatała
+        return start < g.n ? interleavedEuler({ { c.view(), start }, { c.view(), start } }, 2)[1] : vector<int>();
+    } });
+    hamiltonEngines().push_back({ "csrHamilton", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return csrHamilton(c.view(), path) == SolveStatus::Found;
+    } });
+    hamiltonEngines().push_back({ "hamiltonSearch", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        HamiltonSearch search(c.view());
+        // małe kawałki, żeby test przechodził przez wiele wznowień
+        while (!search.resume(7)) {}
+        path = search.cycle();
+        return search.status() == SolveStatus::Found;
+    } });
+    hamiltonEngines().push_back({ "kernelizedHamilton", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return kernelizedHamilton(c.view(), path) == SolveStatus::Found;
+    } });
+    hamiltonEngines().push_back({ "separatorHamilton", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return separatorHamilton(c.view(), path) == SolveStatus::Found;
+    } });
+    hamiltonEngines().push_back({ "satHamilton", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return satHamilton(c.view(), path) == SolveStatus::Found;
+    } });
+    hamiltonEngines().push_back({ "classifiedHamilton", [](Graph& g, vector<int>& path) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        return classifiedHamilton(c.view(), path) == SolveStatus::Found;
+    } });
+}
+
+// Losowy graf G(n, p) bez wymuszonego cyklu - może nie być ani eulerowski, ani hamiltonowski
+Graph randomGraph(int n, double p, mt19937& gen) {
+    Graph g(n);
+    bernoulli_distribution edge(p);
+    for (int u = 0; u < n; ++u)
+        for (int v = u + 1; v < n; ++v)
+            if (edge(gen)) g.addEdge(u, v);
+    return g;
+}
+
+// Pierścień losowych bloków rozdzielonych wierzchołkami-łącznikami: każda para łączników jest
+// separatorem, a cykl Hamiltona istnieje tylko, gdy każdy blok ma ścieżkę Hamiltona między wejściami
+CsrGraph necklaceGraph(int blocks, int size, double p, unsigned seed) {
+    mt19937 gen(seed);
+    bernoulli_distribution edge(p);
+    int stride = size + 1;
+    vector<pair<int, int>> edges;
+    for (int b = 0; b < blocks; ++b) {
+        int base = b * stride, hinge = base + size, next = (b + 1) % blocks * stride;
+        for (int u = 0; u < size; ++u)
+            for (int v = u + 1; v < size; ++v)
+                if (edge(gen)) edges.push_back({ base + u, base + v });
+        edges.push_back({ base + size - 1, hinge });
+        edges.push_back({ base + size - 2, hinge });
+        edges.push_back({ hinge, next });
+        edges.push_back({ hinge, next + 1 });
+    }
+    return CsrGraph::fromEdges(blocks * stride, edges);
+}
+
+// Graf przedziałów jednostkowych, jak z danych o harmonogramach: zadania o tej samej długości
+// startują mniej więcej co 2 / avgDegree, z losowym przesunięciem, i kolidują, gdy się nakładają
+CsrGraph unitIntervalGraph(int n, double avgDegree, unsigned seed) {
+    mt19937 gen(seed);
+    uniform_real_distribution<double> jitter(0, 0.5);
+    vector<pair<double, int>> starts(n);
+    for (int v = 0; v < n; ++v) starts[v] = { v * 2 / avgDegree + jitter(gen), v };
+    sort(starts.begin(), starts.end());
+    // numeracja wierzchołków niezależna od czasu startu
+    vector<int> label(n);
+    for (int v = 0; v < n; ++v) label[v] = v;
+    shuffle(label.begin(), label.end(), gen);
+    vector<pair<int, int>> edges;
+    for (int i = 0; i < n; ++i)
+        for (int j = i + 1; j < n && starts[j].first - starts[i].first <= 1; ++j)
+            edges.push_back({ label[starts[i].second], label[starts[j].second] });
+    return CsrGraph::fromEdges(n, edges);
+}
+
+// Losowy kograf: podział wierzchołków na dwie części połączone sumą albo złączeniem (join
+// z prawdopodobieństwem joinShare), rekurencyjnie aż do pojedynczych wierzchołków
+CsrGraph randomCograph(int n, double joinShare, unsigned seed) {
+    mt19937 gen(seed);
+    bernoulli_distribution join(joinShare);
+    vector<pair<int, int>> edges;
+    vector<int> order(n);
+    for (int v = 0; v < n; ++v) order[v] = v;
+    shuffle(order.begin(), order.end(), gen);
+    vector<pair<int, int>> ranges = { { 0, n } };
+    while (!ranges.empty()) {
+        pair<int, int> r = ranges.back();
+        ranges.pop_back();
+        if (r.second - r.first < 2) continue;
+        int mid = uniform_int_distribution<int>(r.first + 1, r.second - 1)(gen);
+        if (join(gen))
+            for (int i = r.first; i < mid; ++i)
+                for (int j = mid; j < r.second; ++j) edges.push_back({ order[i], order[j] });
+        ranges.push_back({ r.first, mid });
+        ranges.push_back({ mid, r.second });
+    }
+    return CsrGraph::fromEdges(n, edges);
+}
+
+// Losowy graf 3-regularny (n parzyste): suma trzech losowych skojarzeń doskonałych, powtórzone
+// krawędzie zostają. Średniej wielkości grafy tego typu są dla DFS trudne
+CsrGraph randomCubicGraph(int n, unsigned seed) {
+    mt19937 gen(seed);
+    vector<int> order(n);
+    for (int v = 0; v < n; ++v) order[v] = v;
+    vector<pair<int, int>> edges;
+    for (int round = 0; round < 3; ++round) {
+        shuffle(order.begin(), order.end(), gen);
+        for (int i = 0; i + 1 < n; i += 2) edges.push_back({ order[i], order[i + 1] });
+    }
+    return CsrGraph::fromEdges(n, edges);
+}
+
+// Graf pełny wielodzielny o podanych rozmiarach części
+CsrGraph completeMultipartite(const vector<int>& sizes) {
+    vector<int> part;
+    for (int p = 0; p < (int)sizes.size(); ++p) part.insert(part.end(), sizes[p], p);
+    vector<pair<int, int>> edges;
+    for (int u = 0; u < (int)part.size(); ++u)
+        for (int v = u + 1; v < (int)part.size(); ++v)
+            if (part[u] != part[v]) edges.push_back({ u, v });
+    return CsrGraph::fromEdges((int)part.size(), edges);
+}
+
+// Małe grafy o znanych własnościach
+vector<pair<string, Graph>> corpusGraphs() {
+    vector<pair<string, Graph>> corpus;
+
+    Graph k5(5);
+    for (int u = 0; u < 5; ++u)
+        for (int v = u + 1; v < 5; ++v) k5.addEdge(u, v);
+    corpus.push_back({ "K5", k5 });
+
+    Graph petersen(10);
+    for (int i = 0; i < 5; ++i) {
+        petersen.addEdge(i, (i + 1) % 5);
+        petersen.addEdge(i, i + 5);
+        petersen.addEdge(i + 5, (i + 2) % 5 + 5);
+    }
+    corpus.push_back({ "Petersen", petersen });
+
+    Graph k23(5);
+    for (int a = 0; a < 2; ++a)
+        for (int b = 2; b < 5; ++b) k23.addEdge(a, b);
+    corpus.push_back({ "K2,3", k23 });
+
+    Graph bowtie(5);
+    bowtie.addEdge(0, 1); bowtie.addEdge(1, 2); bowtie.addEdge(2, 0);
+    bowtie.addEdge(0, 3); bowtie.addEdge(3, 4); bowtie.addEdge(4, 0);
+    corpus.push_back({ "Motylek", bowtie });
+
+    Graph cube(8);
+    for (int v = 0; v < 8; ++v)
+        for (int b = 1; b < 8; b <<= 1)
+            if (v < (v ^ b)) cube.addEdge(v, v ^ b);
+    corpus.push_back({ "Kostka Q3", cube });
+
+    Graph twoTriangles(6);
+    twoTriangles.addEdge(0, 1); twoTriangles.addEdge(1, 2); twoTriangles.addEdge(2, 0);
+    twoTriangles.addEdge(3, 4); twoTriangles.addEdge(4, 5); twoTriangles.addEdge(5, 3);
+    corpus.push_back({ "Dwa trójkąty", twoTriangles });
+
+    return corpus;
+}
+
+// Porównuje wszystkie zarejestrowane silniki z wersjami referencyjnymi na jednym grafie
+bool differentialCheck(const string& label, Graph& g) {
+    bool ok = true;
+    auto fail = [&](const string& engine, const string& what) {
+        cout << "BŁĄD [" << label << ", n = " << g.n << "] " << engine << ": " << what << "\n";
+        ok = false;
+    };
+
+    if (g.isEulerian()) {
+        vector<int> cycle = referenceEuler(g);
+        if (!verifyEulerCycle(g, cycle)) fail("euler (referencja)", "niepoprawny cykl Eulera");
+        for (auto& e : eulerEngines()) {
+            Graph copy = g;
+            if (!verifyEulerCycle(g, e.solve(copy))) fail(e.name, "niepoprawny cykl Eulera");
+        }
+    }
+
+    vector<int> path;
+    bool expected = referenceHamilton(g, path);
+    if (expected && !verifyHamiltonCycle(g, path)) fail("hamilton (referencja)", "niepoprawny cykl Hamiltona");
+    for (auto& h : hamiltonEngines()) {
+        Graph copy = g;
+        vector<int> p;
+        bool found = h.solve(copy, p);
+        if (found != expected)
+            fail(h.name, found ? "znalazł cykl, którego referencja nie zna" : "nie znalazł istniejącego cyklu");
+        else if (found && !verifyHamiltonCycle(g, p))
+            fail(h.name, "niepoprawny cykl Hamiltona");
+    }
+
+    // Test algebraiczny nie daje certyfikatu, porównujemy tylko odpowiedź (czas O*(2^n), więc małe n)
+    if (g.n <= 9) {
+        CsrGraph c = CsrGraph::fromGraph(g);
+        if ((algebraicHamilton(c.view(), 1) == SolveStatus::Found) != expected)
+            fail("algebraicHamilton", expected ? "nie wykrył istniejącego cyklu" : "wykrył nieistniejący cykl");
+    }
+
+    // Weryfikator musi odrzucić zepsuty certyfikat
+    if (expected && g.n >= 3) {
+        vector<int> broken = path;
+        broken[1] = broken[0];
+        if (verifyHamiltonCycle(g, broken)) fail("weryfikator", "zaakceptował zepsuty cykl Hamiltona");
+    }
+    return ok;
+}
+
+bool differentialTest(int rounds, unsigned seed) {
+    mt19937 gen(seed);
+    uniform_int_distribution<> size(1, 12);
+    uniform_real_distribution<> density(0.1, 0.9);
+    int failures = 0, checked = 0;
+
+    for (auto& c : corpusGraphs()) {
+        failures += !differentialCheck(c.first, c.second);
+        ++checked;
+    }
+    for (int r = 0; r < rounds; ++r) {
+        Graph g = randomGraph(size(gen), density(gen), gen);
+        failures += !differentialCheck("losowy #" + to_string(r), g);
+        ++checked;
+    }
+    for (int n = 5; n <= 30; n += 5) {
+        Graph g = Graph::generateGraph(n, 30.0);
+        failures += !differentialCheck("generateGraph", g);
+        ++checked;
+    }
+
+    cout << "Sprawdzono grafów: " << checked << ", błędów: " << failures << "\n";
+    return failures == 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// Demon rozwiązujący: grafy zmapowane raz przez mmap, zapytania przez gniazdo Unix
+// ---------------------------------------------------------------------------
+
+// Plik zmapowany tylko do odczytu
+class MappedFile {
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        if (!ptr) return false;
+        len = (size_t)fileSize.QuadPart;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) { ptr = p; len = (size_t)st.st_size; }
+        }
+        ::close(fd);
+        if (!ptr) return false;
+#endif
+        return true;
+    }
+
+    void close() {
+        if (!ptr) return;
+#ifdef _WIN32
+        UnmapViewOfFile(ptr);
+#else
+        munmap(ptr, len);
+#endif
+        ptr = nullptr;
+        len = 0;
+    }
+
+    const char* data() const { return (const char*)ptr; }
+    size_t size() const { return len; }
+
+private:
+    void* ptr = nullptr;
+    size_t len = 0;
+};
+
+// Format pliku grafu: nagłówek, offset[n + 1] (int64), target[2m] (int32), edgeId[2m] (int32)
+struct GraphFileHeader {
+    char magic[4];
+    uint32_t version;
+    int64_t n;
+    int64_t m;
+};
+
+bool saveGraphFile(const CsrGraph& g, const string& path) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    GraphFileHeader h = { { 'C', 'S', 'R', 'G' }, 1, g.n, g.m };
+    out.write((const char*)&h, sizeof(h));
+    out.write((const char*)g.offset.data(), g.offset.size() * sizeof(long long));
+    out.write((const char*)g.target.data(), g.target.size() * sizeof(int));
+    out.write((const char*)g.edgeId.data(), g.edgeId.size() * sizeof(int));
+    return (bool)out;
+}
+
+// Ten sam układ co plik grafu, więc segment pamięci współdzielonej i mmap czyta się identycznie
+size_t graphImageSize(long long n, long long m) {
+    return sizeof(GraphFileHeader) + (size_t)(n + 1) * sizeof(long long) + (size_t)m * 4 * sizeof(int);
+}
+
+bool parseGraphImage(const char* data, size_t size, CsrView& view) {
+    if (!data || size < sizeof(GraphFileHeader)) return false;
+    GraphFileHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, "CSRG", 4) != 0 || h.version != 1 || h.n < 0 || h.m < 0) return false;
+    // Nagłówek pochodzi z zewnątrz: ograniczenie n i m przed liczeniem rozmiaru chroni przed przepełnieniem
+    if (h.n > INT_MAX || (unsigned long long)h.m > size / (4 * sizeof(int))) return false;
+    if (size < graphImageSize(h.n, h.m)) return false;
+    CsrView v;
+    v.n = (int)h.n;
+    v.m = h.m;
+    v.offset = (const long long*)(data + sizeof(h));
+    v.target = (const int*)(v.offset + h.n + 1);
+    v.edgeId = v.target + 2 * h.m;
+    if (!csrValid(v)) return false;
+    view = v;
+    return true;
+}
+
+// Nazwany segment pamięci współdzielonej (shm_open / nazwane mapowanie na Windows).
+// Twórca zapisuje CSR raz, pozostałe procesy mapują go tylko do odczytu
+class SharedSegment {
+public:
+    SharedSegment() {}
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+    ~SharedSegment() { close(); }
+
+    bool create(const string& name, size_t size) {
+        close();
+#ifdef _WIN32
+        handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32),
+                                    (DWORD)size, objectName(name).c_str());
+        if (!handle || GetLastError() == ERROR_ALREADY_EXISTS) { close(); return false; }
+        ptr = MapViewOfFile(handle, FILE_MAP_WRITE, 0, 0, size);
+#else
+        int fd = shm_open(objectName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, (off_t)size) == 0) {
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) ptr = p;
+        }
+        ::close(fd);
+        owner = objectName(name);
+        if (!ptr) { close(); return false; }
+#endif
+        len = size;
+        return ptr != nullptr;
+    }
+
+    bool attach(const string& name) {
+        close();
+#ifdef _WIN32
+        handle = OpenFileMappingA(FILE_MAP_READ, FALSE, objectName(name).c_str());
+        if (!handle) return false;
+        ptr = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info;
+        if (ptr && VirtualQuery(ptr, &info, sizeof(info))) len = info.RegionSize;
+#else
+        int fd = shm_open(objectName(name).c_str(), O_RDONLY, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) { ptr = p; len = (size_t)st.st_size; }
+        }
+        ::close(fd);
+#endif
+        return ptr != nullptr;
+    }
+
+    // Segment znika, gdy twórca go zamknie (na Windows dopiero po odłączeniu ostatniego procesu)
+    void close() {
+#ifdef _WIN32
+        if (ptr) UnmapViewOfFile(ptr);
+        if (handle) CloseHandle(handle);
+        handle = nullptr;
+#else
+        if (ptr) munmap(ptr, len);
+        if (!owner.empty()) shm_unlink(owner.c_str());
+        owner.clear();
+#endif
+        ptr = nullptr;
+        len = 0;
+    }
+
+    char* data() const { return (char*)ptr; }
+    size_t size() const { return len; }
+
+private:
+    static string objectName(const string& name) {
+#ifdef _WIN32
+        return "Local\\" + name;
+#else
+        return name[0] == '/' ? name : "/" + name;
+#endif
+    }
+
+#ifdef _WIN32
+    HANDLE handle = nullptr;
+#else
+    string owner;
+#endif
+    void* ptr = nullptr;
+    size_t len = 0;
+};
+
+// Buduje CSR bezpośrednio w segmencie; znacznik formatu jest zapisywany na końcu,
+// więc proces, który dołączy za wcześnie, nie zobaczy niekompletnego grafu
+bool publishSharedGraph(SharedSegment& segment, const string& name, const Graph& g) {
+    long long m = g.edgeCount();
+    if (!segment.create(name, graphImageSize(g.n, m))) return false;
+    char* base = segment.data();
+    GraphFileHeader h = { { 0, 0, 0, 0 }, 1, g.n, m };
+    memcpy(base, &h, sizeof(h));
+    long long* offset = (long long*)(base + sizeof(h));
+    int* target = (int*)(offset + g.n + 1);
+    CsrGraph::fill(g, offset, target, target + 2 * m);
+    atomic_thread_fence(memory_order_release);
+    memcpy(base, "CSRG", 4);
+    return true;
+}
+
+// Graf trzymany w pamięci przez cały czas życia procesu; widok wskazuje wprost na mapowanie.
+// Ścieżka "shm:<nazwa>" dołącza do segmentu pamięci współdzielonej zamiast pliku
+struct ResidentGraph {
+    string path;
+    MappedFile file;
+    SharedSegment shared;
+    CsrView view;
+    // Liczone raz przy wczytaniu, graf jest tylko do odczytu
+    bool eulerian = false;
+    unique_ptr<HybridAdjacency> adjacency;
+
+    bool load(const string& source) {
+        path = source;
+        bool ok = source.compare(0, 4, "shm:") == 0
+                      ? shared.attach(source.substr(4)) && parseGraphImage(shared.data(), shared.size(), view)
+                      : file.open(path) && parseGraphImage(file.data(), file.size(), view);
+        eulerian = ok && csrIsEulerian(view);
+        if (ok) adjacency = hamiltonAdjacency(view);
+        return ok;
+    }
+};
+
+// Pula wątków z priorytetami: najpierw wyższy priorytet, potem wcześniejszy termin, potem FIFO
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads) {
+        if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+        // robotnicy rozłożeni na węzły NUMA, żeby rozwiązania nie konkurowały o jedno gniazdo
+        for (unsigned i = 0; i < threads; ++i)
+            workers.emplace_back([this, i, threads] {
+                pinThreadToNode(NumaTopology::current().homeNode(i, threads));
+                workerLoop();
+            });
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lk(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    void submit(function<void()> run, int priority = 0,
+                steady_clock::time_point deadline = steady_clock::time_point::max()) {
+        {
+            lock_guard<mutex> lk(lock);
+            queue.push({ priority, deadline, seq++, move(run) });
+        }
+        ready.notify_one();
+    }
+
+    size_t size() const { return workers.size(); }
+
+private:
+    struct Task {
+        int priority;
+        steady_clock::time_point deadline;
+        long long seq;
+        function<void()> run;
+    };
+
+    struct Later {
+        bool operator()(const Task& a, const Task& b) const {
+            if (a.priority != b.priority) return a.priority < b.priority;
+            if (a.deadline != b.deadline) return a.deadline > b.deadline;
+            return a.seq > b.seq;
+        }
+    };
+
+    void workerLoop() {
+        for (;;) {
+            function<void()> run;
+            {
+                unique_lock<mutex> lk(lock);
+                ready.wait(lk, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                run = move(const_cast<Task&>(queue.top()).run);
+                queue.pop();
+            }
+            run();
+        }
+    }
+
+    mutex lock;
+    condition_variable ready;
+    priority_queue<Task, vector<Task>, Later> queue;
+    vector<thread> workers;
+    long long seq = 0;
+    bool stopping = false;
+};
+
+#ifdef _WIN32
+typedef SOCKET socket_t;
+const socket_t invalidSocket = INVALID_SOCKET;
+inline void closeSocket(socket_t s) { closesocket(s); }
+inline void shutdownSocket(socket_t s) { shutdown(s, SD_BOTH); }
+#else
+typedef int socket_t;
+const socket_t invalidSocket = -1;
+inline void closeSocket(socket_t s) { ::close(s); }
+inline void shutdownSocket(socket_t s) { shutdown(s, SHUT_RDWR); }
+#endif
+
+// Winsock wymaga inicjalizacji przed pierwszym gniazdem
+struct SocketRuntime {
+#ifdef _WIN32
+    SocketRuntime() { WSADATA d; WSAStartup(MAKEWORD(2, 2), &d); }
+    ~SocketRuntime() { WSACleanup(); }
+#else
+    ~SocketRuntime() {}
+#endif
+};
+
+// Zerwane połączenie ma dać błąd send, a nie SIGPIPE zabijający proces
+#ifdef MSG_NOSIGNAL
+const int sendFlags = MSG_NOSIGNAL;
+#else
+const int sendFlags = 0;
+#endif
+
+bool sendAll(socket_t s, const void* data, size_t len) {
+    const char* p = (const char*)data;
+    while (len > 0) {
+        int k = (int)send(s, p, (int)min(len, (size_t)1 << 30), sendFlags);
+        if (k <= 0) return false;
+        p += k;
+        len -= (size_t)k;
+    }
+    return true;
+}
+
+bool recvAll(socket_t s, void* data, size_t len) {
+    char* p = (char*)data;
+    while (len > 0) {
+        int k = (int)recv(s, p, (int)min(len, (size_t)1 << 30), 0);
+        if (k <= 0) return false;
+        p += k;
+        len -= (size_t)k;
+    }
+    return true;
+}
+
+// Czeka najwyżej ms milisekund, aż gniazdo będzie gotowe do odczytu (albo accept)
+bool waitReadable(socket_t s, int ms) {
+    fd_set ready;
+    FD_ZERO(&ready);
+    FD_SET(s, &ready);
+    timeval timeout;
+    timeout.tv_sec = ms / 1000;
+    timeout.tv_usec = ms % 1000 * 1000;
+    // pierwszy argument Winsock ignoruje
+    return select((int)s + 1, &ready, nullptr, nullptr, &timeout) > 0;
+}
+
+sockaddr_un unixAddress(const string& path) {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+// Adres "unix:<ścieżka>" albo "<host>:<port>" (TCP, host może być pusty przy nasłuchu)
+socket_t openAddress(const string& address, bool listening) {
+    if (address.compare(0, 5, "unix:") == 0) {
+        string path = address.substr(5);
+        socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s == invalidSocket) return s;
+        sockaddr_un addr = unixAddress(path);
+        if (listening) remove(path.c_str());
+        bool ok = listening ? ::bind(s, (sockaddr*)&addr, sizeof(addr)) == 0 && listen(s, 64) == 0
+                            : connect(s, (sockaddr*)&addr, sizeof(addr)) == 0;
+        if (!ok) { closeSocket(s); return invalidSocket; }
+        return s;
+    }
+
+    size_t colon = address.rfind(':');
+    if (colon == string::npos) return invalidSocket;
+    string host = address.substr(0, colon), port = address.substr(colon + 1);
+    addrinfo hints, *list = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = listening ? AI_PASSIVE : 0;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &list) != 0) return invalidSocket;
+    socket_t s = invalidSocket;
+    for (addrinfo* a = list; a && s == invalidSocket; a = a->ai_next) {
+        s = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (s == invalidSocket) continue;
+        int one = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+        if (listening) setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+        bool ok = listening ? ::bind(s, a->ai_addr, (int)a->ai_addrlen) == 0 && listen(s, 64) == 0
+                            : connect(s, a->ai_addr, (int)a->ai_addrlen) == 0;
+        if (!ok) { closeSocket(s); s = invalidSocket; }
+    }
+    freeaddrinfo(list);
+    return s;
+}
+
+// Protokół binarny: stałe nagłówki po 16 bajtów, liczby w kolejności bajtów hosta (gniazdo lokalne)
+enum DaemonOp : uint8_t { OpLoad = 1, OpEuler = 2, OpHamilton = 3, OpShutdown = 4 };
+enum DaemonStatus : uint8_t { StatusOk = 0, StatusNoCycle = 1, StatusTimeout = 2, StatusBadRequest = 3 };
+
+struct DaemonRequest {
+    uint8_t op;
+    uint8_t priority;     // wyższy obsługiwany wcześniej
+    uint16_t pathLength;  // OpLoad: długość ścieżki pliku, która następuje po nagłówku
+    uint32_t graphId;
+    uint32_t start;       // OpEuler: wierzchołek startowy
+    uint32_t deadlineMs;  // 0 = bez terminu
+};
+
+struct DaemonResponse {
+    uint8_t status;
+    uint8_t reserved[3];
+    uint32_t value;       // OpLoad: numer grafu
+    uint32_t count;       // liczba wierzchołków int32 po nagłówku
+    uint32_t micros;      // czas rozwiązywania po stronie demona
+};
+
+static_assert(sizeof(DaemonRequest) == 16 && sizeof(DaemonResponse) == 16, "nagłówki protokołu");
+
+// Zapytanie Hamiltona bez terminu (deadlineMs = 0) dostaje domyślny termin po stronie demona,
+// żeby jedno zapytanie nie blokowało wątku puli ani zamknięcia demona bez końca
+class SolverDaemon {
+public:
+    SolverDaemon(const string& socketPath, unsigned threads, uint32_t defaultDeadline = 30000)
+        : path(socketPath), defaultDeadlineMs(defaultDeadline), pool(threads) {}
+
+    bool run() {
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener == invalidSocket) return false;
+        remove(path.c_str());
+        sockaddr_un addr = unixAddress(path);
+        if (::bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 64) != 0) {
+            closeSocket(listener);
+            return false;
+        }
+        cout << "Demon nasłuchuje na " << path << ", wątki: " << pool.size() << "\n";
+
+        while (running) {
+            socket_t client = accept(listener, nullptr, nullptr);
+            if (!running) {
+                // połączenie budzące z wakeAccept albo spóźniony klient
+                if (client != invalidSocket) closeSocket(client);
+                break;
+            }
+            if (client == invalidSocket) continue;
+            lock_guard<mutex> lk(clientsLock);
+            clients.insert(client);
+            thread([this, client] { serve(client); }).detach();
+        }
+
+        // Zamknięcie: nowi klienci są odrzucani, otwarte połączenia zrywamy i czekamy, aż ich
+        // wątki się zakończą (trwające przeszukiwania są już anulowane przez stopping)
+        closeSocket(listener);
+        remove(path.c_str());
+        unique_lock<mutex> lk(clientsLock);
+        for (socket_t c : clients) shutdownSocket(c);
+        clientsGone.wait(lk, [this] { return clients.empty(); });
+        return true;
+    }
+
+private:
+    void serve(socket_t client) {
+        DaemonRequest req;
+        while (recvAll(client, &req, sizeof(req))) {
+            DaemonResponse res;
+            memset(&res, 0, sizeof(res));
+            vector<int> payload;
+
+            if (req.op == OpLoad) {
+                string file(req.pathLength, '\0');
+                if (!recvAll(client, &file[0], file.size())) break;
+                res.status = loadGraph(file, res.value) ? StatusOk : StatusBadRequest;
+            } else if (req.op == OpEuler || req.op == OpHamilton) {
+                solve(req, res, payload);
+            } else if (req.op == OpShutdown) {
+                sendAll(client, &res, sizeof(res));
+                running = false;
+                stopping.cancelled = true;  // trwające przeszukiwania kończą się jako Timeout
+                wakeAccept();
+                break;
+            } else {
+                res.status = StatusBadRequest;
+            }
+
+            res.count = (uint32_t)payload.size();
+            if (!sendAll(client, &res, sizeof(res)) ||
+                !sendAll(client, payload.data(), payload.size() * sizeof(int)))
+                break;
+        }
+        lock_guard<mutex> lk(clientsLock);
+        clients.erase(client);
+        closeSocket(client);
+        clientsGone.notify_all();
+    }
+
+    // Budzi accept połączeniem do samego siebie: shutdown() gniazda nasłuchującego nie przerywa
+    // blokującego accept na Winsocku, a zamykanie go z innego wątku to wyścig o deskryptor
+    void wakeAccept() {
+        socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s == invalidSocket) return;
+        sockaddr_un addr = unixAddress(path);
+        connect(s, (sockaddr*)&addr, sizeof(addr));
+        closeSocket(s);
+    }
+
+    bool loadGraph(const string& file, uint32_t& id) {
+        lock_guard<mutex> lk(graphsLock);
+        auto it = byPath.find(file);
+        if (it != byPath.end()) { id = it->second; return true; }
+        unique_ptr<ResidentGraph> g(new ResidentGraph());
+        if (!g->load(file)) return false;
+        id = (uint32_t)graphs.size();
+        byPath[file] = id;
+        graphs.push_back(move(g));
+        return true;
+    }
+
+    const ResidentGraph* graph(uint32_t id) {
+        lock_guard<mutex> lk(graphsLock);
+        return id < graphs.size() ? graphs[id].get() : nullptr;
+    }
+
+    // Zadanie trafia do wspólnej puli; wątek połączenia tylko czeka na wynik
+    void solve(const DaemonRequest& req, DaemonResponse& res, vector<int>& payload) {
+        const ResidentGraph* g = graph(req.graphId);
+        if (!g || (req.op == OpEuler && req.start >= (uint32_t)g->view.n)) {
+            res.status = StatusBadRequest;
+            return;
+        }
+        uint32_t deadlineMs = req.deadlineMs ? req.deadlineMs : req.op == OpHamilton ? defaultDeadlineMs : 0;
+        auto deadline = deadlineMs ? steady_clock::now() + milliseconds(deadlineMs) : steady_clock::time_point::max();
+        promise<void> done;
+        pool.submit([&] {
+            auto start = steady_clock::now();
+            if (start >= deadline) {
+                res.status = StatusTimeout;
+            } else if (req.op == OpEuler) {
+                payload = csrEuler(g->view, (int)req.start);
+                // Przy nieparzystych stopniach albo niespójnych krawędziach csrEuler zwraca tylko szlak częściowy
+                res.status = g->eulerian && (long long)payload.size() == g->view.m + 1 ? StatusOk : StatusNoCycle;
+                if (res.status != StatusOk) payload.clear();
+            } else {
+                SearchControl control;
+                control.deadline = deadline;
+                control.parent = &stopping;
+                SolveStatus s = classifiedHamilton(g->view, payload, &control, g->adjacency.get());
+                res.status = s == SolveStatus::Found ? StatusOk
+                           : s == SolveStatus::Aborted ? StatusTimeout : StatusNoCycle;
+            }
+            res.micros = (uint32_t)duration_cast<microseconds>(steady_clock::now() - start).count();
+            done.set_value();
+        }, req.priority, deadline);
+        done.get_future().wait();
+    }
+
+    string path;
+    uint32_t defaultDeadlineMs;
+    ThreadPool pool;
+    socket_t listener = invalidSocket;
+    atomic<bool> running{ true };
+    SearchControl stopping;  // rodzic wszystkich przeszukiwań; anulowany przy zamknięciu
+    mutex graphsLock, clientsLock;
+    vector<unique_ptr<ResidentGraph>> graphs;
+    unordered_map<string, uint32_t> byPath;
+    set<socket_t> clients;
+    condition_variable clientsGone;
+};
+
+// Klient do testów demona: ładuje graf, mierzy czas pojedynczego zapytania i sprawdza certyfikaty
+int runClient(const string& socketPath, const string& graphFile, int queries) {
+    socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = unixAddress(socketPath);
+    if (s == invalidSocket || connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        cout << "Nie można połączyć się z " << socketPath << "\n";
+        return 1;
+    }
+
+    auto call = [&](DaemonRequest req, const string& extra, DaemonResponse& res, vector<int>& out) {
+        if (!sendAll(s, &req, sizeof(req)) || !sendAll(s, extra.data(), extra.size())) return false;
+        if (!recvAll(s, &res, sizeof(res))) return false;
+        out.resize(res.count);
+        return recvAll(s, out.data(), out.size() * sizeof(int));
+    };
+
+    DaemonRequest req;
+    memset(&req, 0, sizeof(req));
+    DaemonResponse res;
+    vector<int> out;
+    req.op = OpLoad;
+    req.pathLength = (uint16_t)graphFile.size();
+    if (!call(req, graphFile, res, out) || res.status != StatusOk) {
+        cout << "Demon nie wczytał grafu " << graphFile << "\n";
+        closeSocket(s);
+        return 1;
+    }
+    uint32_t id = res.value;
+
+    ResidentGraph local;
+    if (!local.load(graphFile)) {
+        cout << "Klient nie wczytał grafu " << graphFile << "\n";
+        closeSocket(s);
+        return 1;
+    }
+    CsrGraph copy;
+    copy.n = local.view.n;
+    copy.m = local.view.m;
+    copy.offset.assign(local.view.offset, local.view.offset + local.view.n + 1);
+    copy.target.assign(local.view.target, local.view.target + 2 * local.view.m);
+    Graph g = copy.toGraph();
+
+    memset(&req, 0, sizeof(req));
+    req.op = OpEuler;
+    req.graphId = id;
+    bool ok = true;
+    uint8_t expected = g.isEulerian() ? StatusOk : StatusNoCycle;
+    auto start = steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+        ok = call(req, "", res, out) && res.status == expected && ok;
+    }
+    auto total = duration_cast<microseconds>(steady_clock::now() - start).count();
+    cout << "Euler: " << queries << " zapytań, średnio " << (queries ? total / queries : 0)
+         << " µs na zapytanie (solver " << res.micros << " µs)\n";
+    if (expected == StatusOk && !verifyEulerCycle(g, out)) {
+        cout << "BŁĄD: niepoprawny cykl Eulera od demona\n";
+        ok = false;
+    }
+
+    req.op = OpHamilton;
+    req.deadlineMs = 1000;
+    req.priority = 1;
+    if (call(req, "", res, out)) {
+        cout << "Hamilton: " << (res.status == StatusOk ? "znaleziony"
+                                 : res.status == StatusTimeout ? "przekroczony termin" : "brak cyklu")
+             << " (" << res.micros << " µs)\n";
+        if (res.status == StatusOk && !verifyHamiltonCycle(g, out)) {
+            cout << "BŁĄD: niepoprawny cykl Hamiltona od demona\n";
+            ok = false;
+        }
+    }
+    closeSocket(s);
+    return ok ? 0 : 1;
+}
+
+int stopDaemon(const string& socketPath) {
+    socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = unixAddress(socketPath);
+    if (s == invalidSocket || connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) return 1;
+    DaemonRequest req;
+    memset(&req, 0, sizeof(req));
+    req.op = OpShutdown;
+    DaemonResponse res;
+    bool ok = sendAll(s, &req, sizeof(req)) && recvAll(s, &res, sizeof(res));
+    closeSocket(s);
+    return ok ? 0 : 1;
+}
+
+// ---------------------------------------------------------------------------
+// Rozproszone przeszukiwanie Hamiltona: koordynator i robotnicy w osobnych procesach
+// ---------------------------------------------------------------------------
+
+// Koordynator -> robotnik: DistGraph (n w count, potem m i tablice CSR), DistUnit (prefiks ścieżki),
+// DistStop. Robotnik -> koordynator: DistResult (status SolveStatus, cykl przy Found).
+// Euler: DistPartition (zakres wierzchołków), DistSegments (końce odcinków),
+// DistOrder (trójki: pozycja w obwodzie, numer odcinka, odwrócony)
+enum DistOp : uint8_t {
+    DistGraph = 1, DistUnit = 2, DistStop = 3, DistResult = 4, DistPartition = 5, DistSegments = 6, DistOrder = 7
+};
+
+struct DistHeader {
+    uint8_t op;
+    uint8_t status;
+    uint16_t reserved;
+    uint32_t unitId;
+    uint32_t count;    // liczba int32 po nagłówku (DistGraph: n)
+    uint32_t sliceMs;  // DistUnit: limit czasu jednostki, 0 = bez limitu
+};
+
+static_assert(sizeof(DistHeader) == 16, "nagłówek protokołu rozproszonego");
+
+bool sendDist(socket_t s, DistHeader h, const vector<int>& payload) {
+    h.count = (uint32_t)payload.size();
+    return sendAll(s, &h, sizeof(h)) && sendAll(s, payload.data(), payload.size() * sizeof(int));
+}
+
+// Drzewo przeszukiwania jest dzielone na prefiksy ścieżki od wierzchołka 0. Robotnicy pobierają
+// jednostki po jednej, więc szybsi dostają ich więcej. Jednostka, która nie zmieściła się
+// w kawałku czasu, wraca, jest dzielona o poziom głębiej i jej dzieci idą na koniec kolejki -
+// trudne poddrzewo nie blokuje robotnika, gdy łatwiejsze jednostki czekają.
+// Pierwszy znaleziony cykl kończy pracę wszystkich robotników
+// Bez żadnego połączonego robotnika przez idleMs (np. robotnicy nie wystartowali) run kończy się
+// wynikiem Aborted zamiast czekać w accept bez końca
+class HamiltonCoordinator {
+public:
+    HamiltonCoordinator(const CsrView& graph, int units, int sliceMs, int idleMs = 10000)
+        : g(graph), targetUnits(units), slice(sliceMs), idle(idleMs) {}
+
+    SolveStatus run(const string& address, vector<int>& cycle) {
+        cycle.clear();
+        if (g.n < 3 || !hamiltonPrescreen(g)) return csrHamilton(g, cycle);
+
+        pending.push_back({ 0 });
+        while (!found && !pending.empty() && (int)pending.size() < targetUnits) {
+            vector<int> prefix = move(pending.front());
+            pending.pop_front();
+            for (auto& child : expand(prefix)) pending.push_back(move(child));
+        }
+        if (found || pending.empty()) {
+            cycle = solution;
+            return found ? SolveStatus::Found : SolveStatus::NotFound;
+        }
+
+        listener = openAddress(address, true);
+        if (listener == invalidSocket) {
+            cout << "Nie można nasłuchiwać na " << address << "\n";
+            return SolveStatus::Aborted;
+        }
+        cout << "Koordynator nasłuchuje na " << address << ", jednostek: " << pending.size() << "\n";
+        thread acceptor([this] { acceptLoop(); });
+        {
+            unique_lock<mutex> lk(lock);
+            changed.wait(lk, [this] { return found || (pending.empty() && inFlight == 0) || abandoned; });
+            done = true;
+            // Rozgłoszenie końca: robotnicy przerywają bieżące jednostki i się rozłączają
+            for (auto& w : workers) {
+                lock_guard<mutex> sending(w->sendLock);
+                DistHeader stop;
+                memset(&stop, 0, sizeof(stop));
+                stop.op = DistStop;
+                sendAll(w->s, &stop, sizeof(stop));
+                shutdownSocket(w->s);
+            }
+        }
+        changed.notify_all();
+        acceptor.join();
+        closeSocket(listener);
+        for (auto& w : workers) {
+            w->handler.join();
+            closeSocket(w->s);
+        }
+
+        cout << "Robotników: " << workers.size() << ", podziałów jednostek: " << splits << ", jednostki:";
+        for (auto& w : workers) cout << " " << w->units;
+        cout << "\n";
+        cycle = solution;
+        if (found) return SolveStatus::Found;
+        if (abandoned) {
+            cout << "Brak połączonych robotników przez " << idle << " ms\n";
+            return SolveStatus::Aborted;
+        }
+        return SolveStatus::NotFound;
+    }
+
+private:
+    struct Worker {
+        socket_t s;
+        mutex sendLock;
+        thread handler;
+        long long units = 0;
+    };
+
+    // Dzieci prefiksu w drzewie przeszukiwania; pełna ścieżka domykająca cykl trafia do solution
+    vector<vector<int>> expand(const vector<int>& prefix) {
+        vector<vector<int>> children;
+        int v = prefix.back();
+        if ((int)prefix.size() == g.n) {
+            for (long long i = g.offset[v]; i < g.offset[v + 1] && !found; ++i)
+                if (g.target[i] == prefix[0]) {
+                    found = true;
+                    solution = prefix;
+                    solution.push_back(prefix[0]);
+                }
+            return children;
+        }
+        vector<char> taken(g.n, 0);
+        for (int u : prefix) taken[u] = 1;
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+            int u = g.target[i];
+            if (taken[u]) continue;
+            taken[u] = 1;
+            children.push_back(prefix);
+            children.back().push_back(u);
+        }
+        return children;
+    }
+
+    // accept tylko po select z krótkim limitem, więc pętla widzi done i czas bez robotników
+    void acceptLoop() {
+        auto lastWorker = steady_clock::now();
+        while (!done) {
+            if (!waitReadable(listener, 100)) {
+                lock_guard<mutex> lk(lock);
+                if (connected > 0) {
+                    lastWorker = steady_clock::now();
+                } else if (steady_clock::now() - lastWorker >= milliseconds(idle)) {
+                    abandoned = true;
+                    changed.notify_all();
+                    break;
+                }
+                continue;
+            }
+            socket_t s = accept(listener, nullptr, nullptr);
+            if (s == invalidSocket) continue;
+            lock_guard<mutex> lk(lock);
+            if (done) {
+                closeSocket(s);
+                break;
+            }
+            ++connected;
+            workers.emplace_back(new Worker());
+            Worker* w = workers.back().get();
+            w->s = s;
+            w->handler = thread([this, w] { serve(*w); });
+        }
+    }
+
+    void serve(Worker& w) {
+        DistHeader h;
+        memset(&h, 0, sizeof(h));
+        h.op = DistGraph;
+        h.count = (uint32_t)g.n;
+        long long m = g.m, halves = g.offset[g.n];
+        bool ok;
+        {
+            lock_guard<mutex> sending(w.sendLock);
+            ok = sendAll(w.s, &h, sizeof(h)) && sendAll(w.s, &m, sizeof(m)) &&
+                 sendAll(w.s, g.offset, ((size_t)g.n + 1) * sizeof(long long)) &&
+                 sendAll(w.s, g.target, (size_t)halves * sizeof(int)) &&
+                 sendAll(w.s, g.edgeId, (size_t)halves * sizeof(int));
+        }
+
+        while (ok) {
+            vector<int> unit;
+            DistHeader request;
+            memset(&request, 0, sizeof(request));
+            request.op = DistUnit;
+            {
+                unique_lock<mutex> lk(lock);
+                changed.wait(lk, [this] { return done || !pending.empty(); });
+                if (done) break;
+                unit = move(pending.front());
+                pending.pop_front();
+                ++inFlight;
+                request.unitId = (uint32_t)nextUnit++;
+                request.sliceMs = (uint32_t)slice;
+            }
+
+            DistHeader reply;
+            vector<int> path;
+            {
+                lock_guard<mutex> sending(w.sendLock);
+                ok = sendDist(w.s, request, unit);
+            }
+            ok = ok && recvAll(w.s, &reply, sizeof(reply)) && reply.op == DistResult;
+            if (ok) {
+                path.resize(reply.count);
+                ok = recvAll(w.s, path.data(), path.size() * sizeof(int));
+            }
+
+            lock_guard<mutex> lk(lock);
+            --inFlight;
+            if (!ok) {
+                // robotnik odpadł - jego jednostka wraca do kolejki
+                if (!done) pending.push_front(move(unit));
+            } else if ((SolveStatus)reply.status == SolveStatus::Aborted) {
+                ++splits;
+                vector<vector<int>> children = expand(unit);
+                for (auto& child : children) pending.push_back(move(child));
+            } else {
+                ++w.units;
+                if ((SolveStatus)reply.status == SolveStatus::Found && !found) {
+                    found = true;
+                    solution = move(path);
+                }
+            }
+            changed.notify_all();
+        }
+        lock_guard<mutex> lk(lock);
+        --connected;
+    }
+
+    CsrView g;
+    int targetUnits, slice, idle;
+    socket_t listener = invalidSocket;
+    atomic<bool> done{ false };
+    mutex lock;
+    condition_variable changed;
+    deque<vector<int>> pending;
+    int inFlight = 0, connected = 0;
+    bool abandoned = false;
+    long long nextUnit = 0, splits = 0;
+    bool found = false;
+    vector<int> solution;
+    vector<unique_ptr<Worker>> workers;
+};
+
+// Robotnik: pobiera graf, potem kolejne jednostki. Przeszukiwanie biegnie w osobnym wątku,
+// żeby DistStop od koordynatora mógł je przerwać w trakcie
+int runHamiltonWorker(const string& address) {
+    socket_t s = invalidSocket;
+    // koordynator mógł jeszcze nie zacząć nasłuchiwać
+    for (int attempt = 0; attempt < 50 && s == invalidSocket; ++attempt) {
+        s = openAddress(address, false);
+        if (s == invalidSocket) this_thread::sleep_for(milliseconds(100));
+    }
+    if (s == invalidSocket) {
+        cout << "Nie można połączyć się z " << address << "\n";
+        return 1;
+    }
+
+    DistHeader h;
+    CsrGraph c;
+    bool ok = recvAll(s, &h, sizeof(h)) && h.op == DistGraph && recvAll(s, &c.m, sizeof(c.m));
+    if (ok) {
+        c.n = (int)h.count;
+        c.offset.resize((size_t)c.n + 1);
+        ok = recvAll(s, c.offset.data(), c.offset.size() * sizeof(long long));
+    }
+    if (ok) {
+        c.target.resize((size_t)c.offset[c.n]);
+        c.edgeId.resize((size_t)c.offset[c.n]);
+        ok = recvAll(s, c.target.data(), c.target.size() * sizeof(int)) &&
+             recvAll(s, c.edgeId.data(), c.edgeId.size() * sizeof(int));
+    }
+    if (!ok) {
+        closeSocket(s);
+        return 1;
+    }
+    CsrView view = c.view();
+    unique_ptr<HybridAdjacency> adjacency = hamiltonAdjacency(view);
+
+    mutex sendLock;
+    unique_ptr<SearchControl> control;
+    thread search;
+    int units = 0;
+    while (recvAll(s, &h, sizeof(h)) && h.op == DistUnit) {
+        vector<int> prefix(h.count);
+        if (!recvAll(s, prefix.data(), prefix.size() * sizeof(int))) break;
+        if (search.joinable()) search.join();
+        control.reset(new SearchControl());
+        if (h.sliceMs) control->deadline = steady_clock::now() + milliseconds(h.sliceMs);
+        SearchControl* current = control.get();
+        uint32_t id = h.unitId;
+        search = thread([&, prefix, current, id] {
+            vector<int> path;
+            SolveStatus status = csrHamiltonFrom(view, prefix, path, current, adjacency.get());
+            DistHeader reply;
+            memset(&reply, 0, sizeof(reply));
+            reply.op = DistResult;
+            reply.status = (uint8_t)status;
+            reply.unitId = id;
+            lock_guard<mutex> lk(sendLock);
+            sendDist(s, reply, status == SolveStatus::Found ? path : vector<int>());
+        });
+        ++units;
+    }
+    if (control) control->cancelled = true;
+    if (search.joinable()) search.join();
+    closeSocket(s);
+    cout << "Robotnik: przeszukanych jednostek " << units << "\n";
+    return 0;
+}
+
+// Kopia tego programu z podanymi argumentami - robotnicy przy testach na jednej maszynie
+#ifdef _WIN32
+typedef HANDLE process_t;
+#else
+typedef pid_t process_t;
+#endif
+
+bool spawnSelf(const char* self, const vector<string>& args, process_t& process) {
+#ifdef _WIN32
+    char exe[MAX_PATH];
+    GetModuleFileNameA(nullptr, exe, MAX_PATH);
+    string command = "\"" + string(exe) + "\"";
+    for (auto& a : args) command += " \"" + a + "\"";
+    STARTUPINFOA startup;
+    memset(&startup, 0, sizeof(startup));
+    startup.cb = sizeof(startup);
+    PROCESS_INFORMATION info;
+    if (!CreateProcessA(nullptr, &command[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &info))
+        return false;
+    CloseHandle(info.hThread);
+    process = info.hProcess;
+    return true;
+#else
+    vector<char*> argv(1, (char*)self);
+    for (auto& a : args) argv.push_back((char*)a.c_str());
+    argv.push_back(nullptr);
+    process = fork();
+    if (process == 0) {
+        execvp(self, argv.data());
+        _exit(127);
+    }
+    return process > 0;
+#endif
+}
+
+void waitProcess(process_t process) {
+#ifdef _WIN32
+    WaitForSingleObject(process, INFINITE);
+    CloseHandle(process);
+#else
+    waitpid(process, nullptr, 0);
+#endif
+}
+
+int distributedDemo(const char* self, int n, double density, int processes, int sliceMs) {
+    Graph g = Graph::generateGraph(n, density);
+    CsrGraph c = CsrGraph::fromGraph(g);
+    const string address = "unix:hamilton-coordinator.sock";
+
+    vector<process_t> children;
+    for (int i = 0; i < processes; ++i) {
+        process_t p;
+        if (spawnSelf(self, { "worker", address }, p)) children.push_back(p);
+    }
+    cout << "n = " << c.n << ", m = " << c.m << ", procesy robotników: " << children.size() << "\n";
+
+    vector<int> cycle;
+    HamiltonCoordinator coordinator(c.view(), 64, sliceMs);
+    auto start = steady_clock::now();
+    SolveStatus s = coordinator.run(address, cycle);
+    auto timeDistributed = duration_cast<microseconds>(steady_clock::now() - start).count();
+    for (auto p : children) waitProcess(p);
+    remove(address.substr(5).c_str());
+    if (s == SolveStatus::Aborted) {
+        cout << "Rozproszone: przerwano - robotnicy się nie połączyli\n";
+        return 1;
+    }
+    bool valid = s != SolveStatus::Found || verifyHamiltonCycle(g, cycle);
+    cout << "Rozproszone: " << (s == SolveStatus::Found ? "cykl znaleziony" : "brak cyklu") << " w "
+         << timeDistributed << " µs" << (valid ? "" : " (BŁĘDNY CERTYFIKAT)") << "\n";
+
+    SearchControl control;
+    control.deadline = steady_clock::now() + seconds(10);
+    start = steady_clock::now();
+    SolveStatus local = csrHamilton(c.view(), cycle, &control);
+    auto timeLocal = duration_cast<microseconds>(steady_clock::now() - start).count();
+    cout << "Jeden proces: " << (local == SolveStatus::Found ? "cykl znaleziony"
+                                 : local == SolveStatus::Aborted ? "przerwano po 10 s" : "brak cyklu")
+         << " w " << timeLocal << " µs\n";
+    bool agree = local == SolveStatus::Aborted || (local == SolveStatus::Found) == (s == SolveStatus::Found);
+    return valid && agree ? 0 : 1;
+}
+
+// Euler rozproszony: koordynator przydziela robotnikom zakresy wierzchołków, zbiera końce
+// ich odcinków, zszywa je w jeden obwód i odsyła każdemu jego odcinki z pozycjami w obwodzie.
+// Przez sieć idą tylko końce odcinków, nie same krawędzie
+// Jak w HamiltonCoordinator: bez nowego robotnika przez idleMs (np. robotnik nie wczytał grafu)
+// koordynator rozłącza tych, którzy już są, i kończy się błędem
+int runEulerCoordinator(const string& address, const vector<long long>& bounds, int idleMs = 10000) {
+    int parts = (int)bounds.size() - 1;
+    socket_t listener = openAddress(address, true);
+    if (listener == invalidSocket) {
+        cout << "Nie można nasłuchiwać na " << address << "\n";
+        return 1;
+    }
+    vector<socket_t> workers;
+    auto lastWorker = steady_clock::now();
+    while ((int)workers.size() < parts) {
+        if (!waitReadable(listener, 100)) {
+            if (steady_clock::now() - lastWorker < milliseconds(idleMs)) continue;
+            cout << "Połączyło się " << workers.size() << " z " << parts << " robotników w ciągu " << idleMs << " ms\n";
+            for (socket_t w : workers) closeSocket(w);
+            closeSocket(listener);
+            return 1;
+        }
+        socket_t s = accept(listener, nullptr, nullptr);
+        if (s == invalidSocket) continue;
+        workers.push_back(s);
+        lastWorker = steady_clock::now();
+    }
+    closeSocket(listener);
+
+    bool ok = true;
+    for (int k = 0; k < parts; ++k) {
+        DistHeader h;
+        memset(&h, 0, sizeof(h));
+        h.op = DistPartition;
+        h.unitId = (uint32_t)k;
+        ok = sendDist(workers[k], h, { (int)bounds[k], (int)bounds[k + 1] }) && ok;
+    }
+
+    // Końce odcinków wszystkich części; owner: (część, numer odcinka w części)
+    vector<pair<int, int>> ends, owner;
+    for (int k = 0; k < parts && ok; ++k) {
+        DistHeader h;
+        vector<int> payload;
+        ok = recvAll(workers[k], &h, sizeof(h)) && h.op == DistSegments;
+        if (ok) {
+            payload.resize(h.count);
+            ok = recvAll(workers[k], payload.data(), payload.size() * sizeof(int));
+        }
+        for (size_t i = 0; ok && i + 1 < payload.size(); i += 2) {
+            owner.push_back({ k, (int)(i / 2) });
+            ends.push_back({ payload[i], payload[i + 1] });
+        }
+    }
+
+    // Bez krawędzi nie ma odcinków: pusty obwód jest poprawny
+    vector<pair<int, bool>> order = ok ? stitchTrails(ends) : vector<pair<int, bool>>();
+    bool circuit = ok && (ends.empty() || !order.empty());
+    vector<vector<int>> assigned(parts);
+    for (size_t position = 0; position < order.size(); ++position) {
+        auto& o = owner[order[position].first];
+        assigned[o.first].insert(assigned[o.first].end(), { (int)position, o.second, (int)order[position].second });
+    }
+    for (int k = 0; k < parts; ++k) {
+        DistHeader h;
+        memset(&h, 0, sizeof(h));
+        h.op = circuit ? DistOrder : DistStop;
+        sendDist(workers[k], h, assigned[k]);
+    }
+    for (int k = 0; k < parts; ++k) {
+        DistHeader h;
+        ok = circuit && recvAll(workers[k], &h, sizeof(h)) && h.op == DistResult && ok;
+        closeSocket(workers[k]);
+    }
+
+    if (!circuit) {
+        cout << (ends.empty() ? "Błąd komunikacji z robotnikami\n"
+                              : "Odcinki nie składają się w obwód - graf nie jest eulerowski\n");
+        return 1;
+    }
+    cout << "Części: " << parts << ", odcinków w obwodzie: " << order.size() << ", na część:";
+    for (auto& a : assigned) cout << " " << a.size() / 3;
+    cout << "\n";
+    return ok ? 0 : 1;
+}
+
+// Robotnik części: graf z pliku CSR albo "shm:<nazwa>" (mapowany, więc czytane są tylko wiersze
+// własnego zakresu). Wynik zapisuje do <prefiks><część>.seg jako rekordy: pozycja w obwodzie
+// (int64), liczba wierzchołków (int64), wierzchołki w kolejności przejścia (int32)
+int runEulerWorker(const string& address, const string& graphSource, const string& outputPrefix) {
+    ResidentGraph graph;
+    if (!graph.load(graphSource)) {
+        cout << "Nie można wczytać grafu " << graphSource << "\n";
+        return 1;
+    }
+    socket_t s = invalidSocket;
+    for (int attempt = 0; attempt < 50 && s == invalidSocket; ++attempt) {
+        s = openAddress(address, false);
+        if (s == invalidSocket) this_thread::sleep_for(milliseconds(100));
+    }
+    if (s == invalidSocket) {
+        cout << "Nie można połączyć się z " << address << "\n";
+        return 1;
+    }
+
+    DistHeader h;
+    vector<int> range(2);
+    bool ok = recvAll(s, &h, sizeof(h)) && h.op == DistPartition && h.count == 2 &&
+              recvAll(s, range.data(), 2 * sizeof(int));
+    int part = (int)h.unitId;
+    vector<vector<int>> segments;
+    if (ok) {
+        segments = partitionTrails(graph.view, range[0], range[1]);
+        vector<int> ends;
+        for (auto& seg : segments) ends.insert(ends.end(), { seg.front(), seg.back() });
+        memset(&h, 0, sizeof(h));
+        h.op = DistSegments;
+        ok = sendDist(s, h, ends);
+    }
+
+    vector<int> assigned;
+    ok = ok && recvAll(s, &h, sizeof(h)) && h.op == DistOrder;
+    if (ok) {
+        assigned.resize(h.count);
+        ok = recvAll(s, assigned.data(), assigned.size() * sizeof(int));
+    }
+    if (ok) {
+        ofstream out(outputPrefix + to_string(part) + ".seg", ios::binary);
+        for (size_t i = 0; i + 2 < assigned.size(); i += 3) {
+            vector<int>& seg = segments[assigned[i + 1]];
+            if (assigned[i + 2]) reverse(seg.begin(), seg.end());
+            long long position = assigned[i], length = (long long)seg.size();
+            out.write((const char*)&position, sizeof(position));
+            out.write((const char*)&length, sizeof(length));
+            out.write((const char*)seg.data(), seg.size() * sizeof(int));
+        }
+        ok = (bool)out;
+        memset(&h, 0, sizeof(h));
+        h.op = DistResult;
+        h.status = ok ? 0 : 1;
+        ok = sendDist(s, h, vector<int>()) && ok;
+    }
+    closeSocket(s);
+    return ok ? 0 : 1;
+}
+
+int distributedEulerDemo(const char* self, int n, int cycles, int processes) {
+    // Suma cykli Hamiltona tasowanych tylko w blokach - lokalność jak po dobrym podziale grafu
+    mt19937_64 gen(1);
+    vector<pair<int, int>> edges;
+    vector<int> order(n);
+    for (int k = 0; k < cycles; ++k) {
+        for (int v = 0; v < n; ++v) order[v] = v;
+        for (int b = 0; b < n; b += 4096) shuffle(order.begin() + b, order.begin() + min(n, b + 4096), gen);
+        for (int i = 0; i < n; ++i) edges.push_back({ order[i], order[(i + 1) % n] });
+    }
+    CsrGraph c = CsrGraph::fromEdges(n, edges);
+    const string address = "unix:euler-coordinator.sock", file = "euler-demo.csrg", prefix = "euler-part-";
+    if (!saveGraphFile(c, file)) return 1;
+
+    // Zakresy wierzchołków o zbliżonej liczbie półkrawędzi
+    vector<long long> bounds(1, 0);
+    for (int k = 1; k < processes; ++k)
+        bounds.push_back(lower_bound(c.offset.begin(), c.offset.end(), c.offset[c.n] * k / processes) - c.offset.begin());
+    bounds.push_back(c.n);
+
+    vector<process_t> children;
+    for (int k = 0; k < processes; ++k) {
+        process_t p;
+        if (spawnSelf(self, { "euler-worker", address, file, prefix }, p)) children.push_back(p);
+    }
+    cout << "n = " << c.n << ", m = " << c.m << ", procesy robotników: " << children.size() << "\n";
+    auto start = steady_clock::now();
+    int result = runEulerCoordinator(address, bounds);
+    auto timeDistributed = duration_cast<microseconds>(steady_clock::now() - start).count();
+    for (auto p : children) waitProcess(p);
+    remove(address.substr(5).c_str());
 
-using namespace std;
-using namespace chrono;
+    // Złożenie odcinków w kolejności pozycji i sprawdzenie certyfikatu
+    map<long long, vector<int>> byPosition;
+    for (int k = 0; k < processes; ++k) {
+        string name = prefix + to_string(k) + ".seg";
+        ifstream in(name, ios::binary);
+        long long position, length;
+        while (in.read((char*)&position, sizeof(position)) && in.read((char*)&length, sizeof(length))) {
+            vector<int>& seg = byPosition[position];
+            seg.resize((size_t)length);
+            in.read((char*)seg.data(), length * sizeof(int));
+        }
+        in.close();
+        remove(name.c_str());
+    }
+    remove(file.c_str());
+    vector<int> cycle;
+    for (auto& entry : byPosition)
+        cycle.insert(cycle.end(), entry.second.begin() + (cycle.empty() ? 0 : 1), entry.second.end());
+    bool valid = result == 0 && verifyEulerCycle(c.view(), cycle);
+    cout << "Rozproszony Euler: " << timeDistributed << " µs, certyfikat: " << (valid ? "poprawny" : "BŁĘDNY") << "\n";
 
-class Graph {
-public:
-    int n;
-    vector<vector<int>> adj;
-    vector<vector<bool>> used;
+    start = steady_clock::now();
+    vector<int> local = csrEuler(c.view(), 0);
+    cout << "Jeden proces: " << duration_cast<microseconds>(steady_clock::now() - start).count() << " µs\n";
+    return valid ? 0 : 1;
+}
 
-    Graph(int size) : n(size), adj(size), used(size, vector<bool>(size, false)) {}
+// ---------------------------------------------------------------------------
+// Asynchroniczne API: wyniki jako Async<T> wykonywane na wspólnej puli wątków
+// ---------------------------------------------------------------------------
+
+ThreadPool& sharedPool() {
+    static ThreadPool pool(0);
+    return pool;
+}
 
+// Wynik obliczenia w toku. Kopie dzielą stan; kontynuacje trafiają do wspólnej puli,
+// a anulowanie ustawia flagę SearchControl sprawdzaną przez przeszukiwanie.
+// Nie należy czekać (get/wait) wewnątrz zadania puli - do tego służą kontynuacje
+template <class T>
+class Async {
+public:
+    Async() : state(make_shared<State>()) {}
 
+    bool isReady() const {
+        lock_guard<mutex> lk(state->lock);
+        return state->ready;
+    }
 
-    void addEdge(int u, int v) {
-        adj[u].push_back(v);
-        adj[v].push_back(u);
-        used[u][v] = used[v][u] = false;
+    void wait() const {
+        unique_lock<mutex> lk(state->lock);
+        state->done.wait(lk, [this] { return state->ready; });
     }
 
-    static Graph generateGraph(int n, double densityPercent) {
-        Graph g(n);
-        int maxEdges = n * (n - 1) / 2;
-        int edgeCount = (int)(densityPercent / 100.0 * maxEdges);
+    T get() const {
+        wait();
+        if (state->error) rethrow_exception(state->error);
+        return state->value;
+    }
 
-        // Tworzymy spójny cykl bazowy (Hamilton i Euler)
-        for (int i = 0; i < n - 1; ++i)
-            g.addEdge(i, i + 1);
-        g.addEdge(n - 1, 0);
+    void cancel() const {
+        vector<shared_ptr<SearchControl>> linked;
+        {
+            lock_guard<mutex> lk(state->lock);
+            linked = state->linked;
+        }
+        state->control->cancelled = true;
+        for (auto& c : linked) c->cancelled = true;
+    }
 
-        set<pair<int, int>> existingEdges;
-        for (int i = 0; i < n; ++i)
-            for (int j : g.adj[i])
-                if (i < j) existingEdges.insert({ i, j });
+    const shared_ptr<SearchControl>& control() const { return state->control; }
 
-        random_device rd;
-        mt19937 gen(rd());
-        uniform_int_distribution<> dist(0, n - 1);
+    // Anulowanie tego wyniku anuluje też podane obliczenia (używane przez whenAll / whenAny)
+    void link(const shared_ptr<SearchControl>& other) const {
+        lock_guard<mutex> lk(state->lock);
+        state->linked.push_back(other);
+    }
 
-        while ((int)existingEdges.size() < edgeCount) {
-            int u = dist(gen), v = dist(gen);
-            if (u == v) continue;
-            pair<int, int> e = { min(u,v), max(u,v) };
-            if (existingEdges.count(e)) continue;
-            g.addEdge(u, v);
-            existingEdges.insert(e);
+    // Wywołanie zwrotne zaraz po zakończeniu, w wątku, który je zakończył
+    void onReady(function<void()> callback) const {
+        unique_lock<mutex> lk(state->lock);
+        if (!state->ready) {
+            state->callbacks.push_back(move(callback));
+            return;
         }
+        lk.unlock();
+        callback();
+    }
 
-        // Dopilnuj, żeby każdy wierzchołek miał parzysty stopień (Euler)
-        for (int i = 0; i < n; ++i) {
-            if (g.adj[i].size() % 2 != 0) {
-                int j = (i + 1) % n;
-                // Sprawdź, czy krawędź już istnieje, aby uniknąć duplikatu
-                pair<int, int> e = { min(i,j), max(i,j) };
-                if (existingEdges.count(e) == 0) {
-                    g.addEdge(i, j);
-                    existingEdges.insert(e);
+    // Kontynuacja f(wynik) w puli; dzieli anulowanie z poprzednikiem
+    template <class F>
+    Async<decltype(declval<F>()(declval<T>()))> then(F f, int priority = 0) const {
+        typedef decltype(declval<F>()(declval<T>())) R;
+        Async<R> next;
+        next.link(state->control);
+        Async self = *this;
+        onReady([self, next, f, priority] {
+            sharedPool().submit([self, next, f]() mutable {
+                try {
+                    next.complete(f(self.get()));
+                } catch (...) {
+                    next.fail(current_exception());
                 }
+            }, priority);
+        });
+        return next;
+    }
+
+    // Pierwsze zakończenie wygrywa, kolejne są ignorowane (potrzebne przy wyścigu)
+    void complete(T value) const { finish(move(value), nullptr); }
+    void fail(exception_ptr error) const { finish(T(), error); }
+
+private:
+    struct State {
+        mutex lock;
+        condition_variable done;
+        bool ready = false;
+        T value;
+        exception_ptr error;
+        vector<function<void()>> callbacks;
+        shared_ptr<SearchControl> control = make_shared<SearchControl>();
+        vector<shared_ptr<SearchControl>> linked;
+    };
+
+    void finish(T value, exception_ptr error) const {
+        vector<function<void()>> callbacks;
+        {
+            lock_guard<mutex> lk(state->lock);
+            if (state->ready) return;
+            state->value = move(value);
+            state->error = error;
+            state->ready = true;
+            callbacks.swap(state->callbacks);
+        }
+        state->done.notify_all();
+        for (auto& c : callbacks) c();
+    }
+
+    shared_ptr<State> state;
+};
+
+template <class F>
+Async<decltype(declval<F>()())> runAsync(F f, int priority = 0) {
+    Async<decltype(declval<F>()())> result;
+    sharedPool().submit([result, f]() mutable {
+        try {
+            result.complete(f());
+        } catch (...) {
+            result.fail(current_exception());
+        }
+    }, priority);
+    return result;
+}
+
+// Tablice widoku muszą żyć do zakończenia obliczenia
+Async<vector<int>> solveEulerAsync(const CsrView& g, int start = 0, int priority = 0) {
+    return runAsync([g, start] { return csrEuler(g, start); }, priority);
+}
+
+struct HamiltonResult {
+    SolveStatus status = SolveStatus::NotFound;
+    vector<int> cycle;
+};
+
+Async<HamiltonResult> solveHamiltonAsync(const CsrView& g, int priority = 0,
+                                         milliseconds timeout = milliseconds(0)) {
+    Async<HamiltonResult> result;
+    shared_ptr<SearchControl> control = result.control();
+    if (timeout.count() > 0) control->deadline = steady_clock::now() + timeout;
+    sharedPool().submit([result, control, g] {
+        HamiltonResult r;
+        r.status = control->cancelled ? SolveStatus::Aborted : csrHamilton(g, r.cycle, control.get());
+        result.complete(move(r));
+    }, priority, control->deadline);
+    return result;
+}
+
+// Kończy się, gdy zakończą się wszystkie części; wyniki w kolejności wejścia
+template <class T>
+Async<vector<T>> whenAll(const vector<Async<T>>& parts) {
+    Async<vector<T>> all;
+    if (parts.empty()) {
+        all.complete(vector<T>());
+        return all;
+    }
+    auto left = make_shared<atomic<size_t>>(parts.size());
+    for (auto& p : parts) {
+        all.link(p.control());
+        p.onReady([all, parts, left] {
+            if (--*left != 0) return;
+            try {
+                vector<T> values;
+                for (auto& q : parts) values.push_back(q.get());
+                all.complete(move(values));
+            } catch (...) {
+                all.fail(current_exception());
+            }
+        });
+    }
+    return all;
+}
+
+// Wyścig: wynik pierwszej zakończonej części (indeks, wartość); pozostałe są anulowane.
+// Bez części nie ma zwycięzcy, więc wynik od razu kończy się wyjątkiem invalid_argument
+template <class T>
+Async<pair<size_t, T>> whenAny(const vector<Async<T>>& parts) {
+    Async<pair<size_t, T>> first;
+    if (parts.empty()) {
+        first.fail(make_exception_ptr(invalid_argument("whenAny bez części")));
+        return first;
+    }
+    for (size_t i = 0; i < parts.size(); ++i) {
+        first.link(parts[i].control());
+        parts[i].onReady([first, parts, i] {
+            if (first.isReady()) return;
+            try {
+                first.complete(make_pair(i, parts[i].get()));
+            } catch (...) {
+                first.fail(current_exception());
             }
+            for (auto& q : parts) q.cancel();
+        });
+    }
+    return first;
+}
+
+// Porównanie potoku sekwencyjnego z asynchronicznym: generowanie, Euler i Hamilton nachodzą na siebie
+void asyncDemo(int graphs, int n, double density) {
+    auto start = steady_clock::now();
+    int found = 0;
+    for (int i = 0; i < graphs; ++i) {
+        CsrGraph c = CsrGraph::fromGraph(Graph::generateGraph(n, density));
+        vector<int> path;
+        csrEuler(c.view(), 0);
+        found += csrHamilton(c.view(), path) == SolveStatus::Found;
+    }
+    auto sequential = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    vector<Async<size_t>> tours;
+    vector<Async<HamiltonResult>> cycles;
+    for (int i = 0; i < graphs; ++i) {
+        auto loaded = runAsync([n, density] {
+            return make_shared<CsrGraph>(CsrGraph::fromGraph(Graph::generateGraph(n, density)));
+        });
+        tours.push_back(loaded.then([](shared_ptr<CsrGraph> c) { return csrEuler(c->view(), 0).size(); }));
+        cycles.push_back(loaded.then([](shared_ptr<CsrGraph> c) {
+            HamiltonResult r;
+            r.status = csrHamilton(c->view(), r.cycle);
+            return r;
+        }));
+    }
+    whenAll(tours).wait();
+    int asyncFound = 0;
+    for (auto& r : whenAll(cycles).get())
+        asyncFound += r.status == SolveStatus::Found;
+    auto overlapped = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    cout << "Grafów: " << graphs << ", n = " << n << ", wątki: " << sharedPool().size() << "\n";
+    cout << "Sekwencyjnie: " << sequential << " µs, cykli Hamiltona: " << found << "\n";
+    cout << "Asynchronicznie: " << overlapped << " µs, cykli Hamiltona: " << asyncFound << "\n";
+}
+
+// ---------------------------------------------------------------------------
+// Planista wielu przeszukiwań Hamiltona w kawałkach po N węzłów
+// ---------------------------------------------------------------------------
+
+// Zadanie dostaje kawałek węzłów, po którym wraca do kolejki, więc kilka długich zapytań nie
+// blokuje krótkich. RoundRobin - po kolei; ShortestFirst - najpierw to, które zużyło dotąd
+// najmniej węzłów (trudności nie znamy z góry, więc za najkrótsze oczekiwane uchodzi najmniej
+// obsłużone); RunToCompletion - FIFO bez wywłaszczania, jak w solveHamiltonAsync
+class SliceScheduler {
+public:
+    enum Policy { RunToCompletion, RoundRobin, ShortestFirst };
+
+    SliceScheduler(unsigned threads, long long sliceNodes, Policy order)
+        : slice(sliceNodes), policy(order), queue(Later{ order }) {
+        threads = defaultThreads(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    // Zadania, które nie zdążyły się zakończyć, kończą się jako Aborted
+    ~SliceScheduler() {
+        {
+            lock_guard<mutex> lk(lock);
+            stopping = true;
         }
+        ready.notify_all();
+        for (auto& w : workers) w.join();
+    }
 
-        return g;
+    // Tablice widoku muszą żyć do zakończenia; anulowanie i termin przez control() wyniku
+    Async<HamiltonResult> submit(const CsrView& g, milliseconds timeout = milliseconds(0)) {
+        Async<HamiltonResult> result;
+        if (timeout.count() > 0) result.control()->deadline = steady_clock::now() + timeout;
+        shared_ptr<Task> task = make_shared<Task>(g, result);
+        {
+            lock_guard<mutex> lk(lock);
+            task->seq = seq++;
+            queue.push(task);
+        }
+        ready.notify_one();
+        return result;
     }
 
-    void resetUsed() {
-        used = vector<vector<bool>>(n, vector<bool>(n, false));
+private:
+    struct Task {
+        Task(const CsrView& g, const Async<HamiltonResult>& r) : search(g), result(r) {}
+        HamiltonSearch search;
+        Async<HamiltonResult> result;
+        long long seq = 0;  // kolejność wejścia albo powrotu do kolejki
+    };
+
+    struct Later {
+        Policy policy;
+        bool operator()(const shared_ptr<Task>& a, const shared_ptr<Task>& b) const {
+            if (policy == ShortestFirst && a->search.nodes() != b->search.nodes())
+                return a->search.nodes() > b->search.nodes();
+            return a->seq > b->seq;
+        }
+    };
+
+    void workerLoop() {
+        for (;;) {
+            shared_ptr<Task> task;
+            bool stop;
+            {
+                unique_lock<mutex> lk(lock);
+                ready.wait(lk, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return;
+                task = queue.top();
+                queue.pop();
+                stop = stopping;
+            }
+            SearchControl& control = *task->result.control();
+            bool expired = stop || control.cancelled ||
+                           (control.deadline != steady_clock::time_point::max() && steady_clock::now() >= control.deadline);
+            if (!expired && !task->search.resume(policy == RunToCompletion ? LLONG_MAX : slice)) {
+                lock_guard<mutex> lk(lock);
+                task->seq = seq++;
+                queue.push(task);
+                continue;
+            }
+            HamiltonResult r;
+            r.status = expired ? SolveStatus::Aborted : task->search.status();
+            r.cycle = task->search.cycle();
+            task->result.complete(move(r));
+        }
     }
 
-    void euler(int v, vector<int>& cycle) {
-        for (int u : adj[v]) {
-            if (!used[v][u]) {
-                used[v][u] = used[u][v] = true;
-                euler(u, cycle);
+    long long slice;
+    Policy policy;
+    mutex lock;
+    condition_variable ready;
+    priority_queue<shared_ptr<Task>, vector<shared_ptr<Task>>, Later> queue;
+    long long seq = 0;
+    bool stopping = false;
+    vector<thread> workers;
+};
+
+// Mieszane obciążenie: co "every"-te zapytanie to trudny graf bez cyklu (dwie kliki ze wspólnym
+// wierzchołkiem), reszta to łatwe grafy z cyklem. Wszystkie przychodzą naraz
+void sliceDemo(int queries, int n, int every, long long slice, unsigned threads) {
+    vector<CsrGraph> graphs;
+    const int k = 10;
+    vector<pair<int, int>> bridge;
+    for (int side = 0; side < 2; ++side)
+        for (int i = 0; i < k; ++i)
+            for (int j = i + 1; j < k; ++j)
+                bridge.push_back({ i ? side * (k - 1) + i : 0, side * (k - 1) + j });
+    for (int q = 0; q < queries; ++q)
+        graphs.push_back(q % every == 0 ? CsrGraph::fromEdges(2 * k - 1, bridge)
+                                        : CsrGraph::fromGraph(Graph::generateGraph(n, 30)));
+
+    HamiltonSearch probe(graphs[0].view());
+    probe.resume(slice);
+    cout << "Stan zawieszonego przeszukiwania: " << probe.stateBytes() << " B\n";
+
+    const char* names[] = { "do końca (FIFO)", "round-robin", "najkrótsze najpierw" };
+    for (int p = 0; p < 3; ++p) {
+        vector<long long> latency(queries);
+        int found = 0;
+        auto start = steady_clock::now();
+        {
+            SliceScheduler scheduler(threads, slice, (SliceScheduler::Policy)p);
+            vector<Async<HamiltonResult>> results;
+            for (int q = 0; q < queries; ++q) {
+                results.push_back(scheduler.submit(graphs[q].view()));
+                results.back().onReady([&latency, q, start] {
+                    latency[q] = duration_cast<microseconds>(steady_clock::now() - start).count();
+                });
             }
+            for (auto& r : results) found += r.get().status == SolveStatus::Found;
         }
-        cycle.push_back(v);
+        auto total = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        sort(latency.begin(), latency.end());
+        cout << names[p] << ": mediana " << latency[queries / 2] << " µs, p99 "
+             << latency[min(queries - 1, queries * 99 / 100)] << " µs, maks. " << latency.back()
+             << " µs, całość " << total << " ms, cykli: " << found << "\n";
     }
+}
 
-    bool hamiltonUtil(int v, vector<bool>& visited, vector<int>& path, int depth) {
-        path.push_back(v);
-        visited[v] = true;
+// ---------------------------------------------------------------------------
+// Raportowanie postępu długich przeszukiwań
+// ---------------------------------------------------------------------------
 
-        if (depth == n) {
-            for (int u : adj[v]) {
-                if (u == path[0]) {
-                    path.push_back(path[0]);
-                    return true;
-                }
+// Wątek, który co interval odczytuje SearchProgress i wypisuje jeden wiersz na stderr
+// albo dopisuje wiersz CSV do pliku statystyk. Solver nie wie o raporterze
+class ProgressReporter {
+public:
+    ProgressReporter(const SearchProgress& progress, milliseconds interval, const string& statsFile = "")
+        : progress(progress), interval(interval) {
+        if (!statsFile.empty()) {
+            stats.open(statsFile);
+            stats << "czas_s,wezly,wezly_na_s,glebokosc,max_glebokosc,odciecia_proc,nawroty,zbadano_proc,profil\n";
+        }
+        worker = thread([this] { run(); });
+    }
+
+    ~ProgressReporter() {
+        {
+            lock_guard<mutex> lk(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+        report();
+    }
+
+private:
+    void run() {
+        unique_lock<mutex> lk(lock);
+        while (!wake.wait_for(lk, interval, [this] { return stopping; })) {
+            lk.unlock();
+            report();
+            lk.lock();
+        }
+    }
+
+    // Profil głębokości: udział próbek w dziesięciu równych przedziałach głębokości
+    string depthProfile() const {
+        const size_t buckets = 10;
+        vector<long long> sum(buckets, 0);
+        long long total = 0;
+        size_t levels = progress.depthSamples.size();
+        for (size_t d = 0; d < levels; ++d) {
+            long long k = progress.depthSamples[d].load(memory_order_relaxed);
+            sum[d * buckets / levels] += k;
+            total += k;
+        }
+        string profile;
+        for (size_t b = 0; b < buckets; ++b) {
+            if (b) profile += ' ';
+            profile += to_string(total ? sum[b] * 100 / total : 0);
+        }
+        return profile;
+    }
+
+    void report() {
+        double seconds = duration<double>(steady_clock::now() - progress.started).count();
+        long long nodes = progress.nodes.load(memory_order_relaxed);
+        long long pruned = progress.pruned.load(memory_order_relaxed);
+        long long backtracks = progress.backtracks.load(memory_order_relaxed);
+        double rate = (nodes - lastNodes) / max(1e-9, seconds - lastSeconds);
+        double pruneRate = nodes + pruned ? 100.0 * pruned / (nodes + pruned) : 0;
+        double explored = 100.0 * progress.exploredFraction();
+        lastNodes = nodes;
+        lastSeconds = seconds;
+
+        if (stats.is_open()) {
+            stats << seconds << ',' << nodes << ',' << (long long)rate << ',' << progress.depth << ','
+                  << progress.maxDepth << ',' << pruneRate << ',' << backtracks << ',' << explored << ','
+                  << depthProfile() << '\n' << flush;
+            return;
+        }
+        cerr << "[" << (long long)(seconds * 10) / 10.0 << " s] węzły: " << nodes << " (" << (long long)rate
+             << "/s), głębokość: " << progress.depth << " (max " << progress.maxDepth << "), odcięcia: "
+             << (int)pruneRate << "%, nawroty: " << backtracks << ", zbadano ≈ " << explored
+             << "%, profil [" << depthProfile() << "]\n";
+    }
+
+    const SearchProgress& progress;
+    milliseconds interval;
+    ofstream stats;
+    thread worker;
+    mutex lock;
+    condition_variable wake;
+    bool stopping = false;
+    long long lastNodes = 0;
+    double lastSeconds = 0;
+};
+
+// Przeszukiwanie z raportem postępu; dla porównania najpierw bez niego, żeby zmierzyć narzut
+void progressDemo(int n, double density, milliseconds interval, const string& statsFile) {
+    CsrGraph c = CsrGraph::fromGraph(Graph::generateGraph(n, density));
+    vector<int> path;
+
+    auto start = steady_clock::now();
+    csrHamilton(c.view(), path);
+    auto plain = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    SearchProgress progress(c.n);
+    SearchControl control;
+    control.progress = &progress;
+    SolveStatus s;
+    start = steady_clock::now();
+    {
+        ProgressReporter reporter(progress, interval, statsFile);
+        s = csrHamilton(c.view(), path, &control);
+    }
+    auto reported = duration_cast<microseconds>(steady_clock::now() - start).count();
+
+    cout << "Cykl Hamiltona " << (s == SolveStatus::Found ? "znaleziony" : "nie znaleziony")
+         << ", bez raportu: " << plain << " µs, z raportem: " << reported << " µs\n";
+}
+
+// Graf o skośnym rozkładzie stopni (kilka hubów połączonych z częścią wierzchołków plus losowe
+// krawędzie) i porównanie testu krawędzi: skan CSR, reprezentacja hybrydowa, pełna macierz bitowa
+void adjacencyDemo(int n, double avgDegree, int hubs, int queries) {
+    mt19937 gen(7);
+    uniform_int_distribution<int> vertex(0, n - 1);
+    bernoulli_distribution hubEdge(0.3);
+    vector<pair<int, int>> edges;
+    for (int h = 0; h < hubs; ++h)
+        for (int v = hubs; v < n; ++v)
+            if (hubEdge(gen)) edges.push_back({ h, v });
+    for (long long e = 0; e < (long long)(avgDegree * n / 2); ++e) {
+        int u = vertex(gen), v = vertex(gen);
+        if (u != v) edges.push_back({ u, v });
+    }
+    CsrGraph c = CsrGraph::fromEdges(n, edges);
+    HybridAdjacency hybrid(c.view());
+
+    vector<pair<int, int>> probes(queries);
+    for (int i = 0; i < queries; ++i) {
+        // połowa zapytań dotyczy hubów, bo to one dominują w przeszukiwaniach
+        probes[i].first = i % 2 ? vertex(gen) % max(1, hubs) : vertex(gen);
+        probes[i].second = vertex(gen);
+    }
+
+    long long hitsScan = 0, hitsHybrid = 0;
+    auto start = steady_clock::now();
+    for (auto& q : probes)
+        hitsScan += count(c.target.begin() + (size_t)c.offset[q.first], c.target.begin() + (size_t)c.offset[q.first + 1],
+                          q.second) > 0;
+    auto timeScan = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    start = steady_clock::now();
+    for (auto& q : probes) hitsHybrid += hybrid.hasEdge(q.first, q.second);
+    auto timeHybrid = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+    cout << "n = " << c.n << ", m = " << c.m << ", huby: " << hybrid.hubCount() << "\n";
+    cout << "Skan CSR: " << timeScan << " ms, hybryda: " << timeHybrid << " ms, zgodność: "
+         << (hitsScan == hitsHybrid ? "TAK" : "NIE") << "\n";
+    cout << "Pamięć: hybryda " << hybrid.memoryBytes() / 1024 << " KiB, pełna macierz bitowa "
+         << (long long)n * n / 8 / 1024 << " KiB\n";
+}
+
+void interleaveDemo(int graphs, int n, int cycles, int width) {
+    vector<CsrGraph> store;
+    vector<EulerTask> tasks;
+    for (int i = 0; i < graphs; ++i) store.push_back(randomEulerianCsr(n, cycles, 100 + i));
+    for (auto& c : store) tasks.push_back({ c.view(), 0 });
+
+    auto start = steady_clock::now();
+    vector<vector<int>> sequential;
+    for (auto& t : tasks) sequential.push_back(csrEuler(t.g, t.start));
+    auto timeSequential = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    start = steady_clock::now();
+    vector<vector<int>> batched = interleavedEuler(tasks, width);
+    auto timeBatched = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+    cout << graphs << " grafów, n = " << n << ", m = " << store[0].m << ", szerokość partii: " << width << "\n";
+    cout << "Po kolei: " << timeSequential << " ms, przeplatane: " << timeBatched << " ms, zgodność: "
+         << (sequential == batched ? "TAK" : "NIE") << "\n";
+}
+
+// Na którym węźle NUMA leżą strony bufora (próbka do 4096 stron). Pozycja k to k-ty węzeł
+// z NumaTopology, ostatnia - strony nieprzydzielone albo brak wsparcia systemu
+vector<long long> pageNodes(const void* data, size_t bytes) {
+    const NumaTopology& t = NumaTopology::current();
+    vector<long long> counts(t.nodes() + 1, 0);
+    auto record = [&](int node) {
+        size_t k = find(t.id.begin(), t.id.end(), node) - t.id.begin();
+        ++counts[min(k, (size_t)t.nodes())];
+    };
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uintptr_t pageSize = info.dwPageSize;
+#else
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+#endif
+    uintptr_t first = (uintptr_t)data & ~(pageSize - 1);
+    size_t pages = (size_t)(((uintptr_t)data + bytes - first + pageSize - 1) / pageSize);
+    size_t step = max<size_t>(1, pages / 4096);
+    vector<void*> addresses;
+    for (size_t p = 0; p < pages; p += step) addresses.push_back((void*)(first + p * pageSize));
+#ifdef _WIN32
+    vector<PSAPI_WORKING_SET_EX_INFORMATION> query(addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) query[i].VirtualAddress = addresses[i];
+    bool ok = QueryWorkingSetEx(GetCurrentProcess(), query.data(), (DWORD)(query.size() * sizeof(query[0]))) != 0;
+    for (auto& q : query) record(ok && q.VirtualAttributes.Valid ? (int)q.VirtualAttributes.Node : -1);
+#elif defined(__linux__) && defined(SYS_move_pages)
+    // move_pages bez węzłów docelowych tylko odczytuje położenie stron
+    vector<int> status(addresses.size(), -1);
+    bool ok = syscall(SYS_move_pages, 0, (unsigned long)addresses.size(), addresses.data(), nullptr, status.data(), 0) == 0;
+    for (int node : status) record(ok ? node : -1);
+#else
+    for (size_t i = 0; i < addresses.size(); ++i) record(-1);
+#endif
+    return counts;
+}
+
+void numaDemo(int n, double avgDegree, unsigned threads) {
+    const NumaTopology& t = NumaTopology::current();
+    cout << "Węzły NUMA: " << t.nodes() << "\n";
+    for (int k = 0; k < t.nodes(); ++k)
+        cout << "  węzeł " << t.id[k] << ": " << t.cpus[k].size() << " procesorów\n";
+
+    // randomSparseCsr buduje graf jednym wątkiem - wszystkie strony lądują przy nim
+    CsrGraph plain = randomSparseCsr(n, avgDegree, 1);
+    NumaCsrGraph placed = NumaCsrGraph::place(plain.view(), threads);
+    auto printPages = [&](const char* name, const int* target) {
+        vector<long long> counts = pageNodes(target, (size_t)plain.offset[n] * sizeof(int));
+        cout << name << " strony tablicy sąsiadów:";
+        for (int k = 0; k < t.nodes(); ++k) cout << " węzeł " << t.id[k] << " = " << counts[k] << ",";
+        cout << " nieznane = " << counts[t.nodes()] << "\n";
+    };
+    printPages("Budowa jednowątkowa:", plain.target.data());
+    printPages("Rozmieszczenie NUMA:", placed.target.get());
+
+    // Wątek węzła k przegląda wiersze swoich wierzchołków (lokalnie) i odczytuje stan
+    // sąsiadów - zdalnie, jeśli sąsiad należy do zakresu innego węzła
+    long long local = 0, remote = 0;
+    for (int v = 0; v < n; ++v)
+        for (long long i = placed.offset[v]; i < placed.offset[v + 1]; ++i)
+            (placed.nodeOf(placed.target[i]) == placed.nodeOf(v) ? local : remote)++;
+    cout << "Dostępy do sąsiadów przy podziale na zakresy: lokalne " << local << ", zdalne " << remote;
+    if (local + remote) cout << " (" << 100 * remote / (local + remote) << "% zdalnych)";
+    cout << "\n";
+
+    auto start = steady_clock::now();
+    int componentsPlain = componentCount(connectedComponents(plain.view(), threads));
+    auto timePlain = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    start = steady_clock::now();
+    int componentsPlaced = componentCount(connectedComponents(placed.view(), threads));
+    auto timePlaced = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    cout << "Składowe: budowa jednowątkowa " << timePlain << " ms, rozmieszczenie NUMA " << timePlaced
+         << " ms, zgodność: " << (componentsPlain == componentsPlaced ? "TAK" : "NIE") << "\n";
+}
+
+
+// Strumień aktualizacji na grafie zmiennym, a obok czytelnik liczący składowe na migawkach
+void dynamicDemo(int n, double avgDegree, int updates, milliseconds interval) {
+    DynamicGraph graph(n, interval);
+    mt19937 gen(3);
+    uniform_int_distribution<int> vertex(0, n - 1);
+    vector<int> ids;
+    for (long long e = 0; e < (long long)(avgDegree * n / 2); ++e) ids.push_back(graph.addEdge(vertex(gen), vertex(gen)));
+    graph.compact();
+
+    atomic<bool> writing{ true };
+    atomic<int> passes{ 0 };
+    thread reader([&] {
+        while (writing) {
+            shared_ptr<const GraphSnapshot> s = graph.snapshot();
+            componentCount(connectedComponents(s->csr.view(), 1));
+            ++passes;
+        }
+    });
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < updates; ++i) {
+        if (ids.empty() || gen() % 2) {
+            int v = i % 1000 == 0 ? graph.addVertex() : vertex(gen);
+            ids.push_back(graph.addEdge(vertex(gen), v));
+        } else {
+            size_t k = gen() % ids.size();
+            int id = ids[k];
+            ids[k] = ids.back();
+            ids.pop_back();
+            graph.removeEdge(id);
+        }
+    }
+    auto timeUpdates = duration_cast<microseconds>(steady_clock::now() - start).count();
+    writing = false;
+    reader.join();
+
+    // Ostatnia migawka musi się zgadzać z grafem co do krawędzi i stopni
+    start = steady_clock::now();
+    shared_ptr<const GraphSnapshot> last = graph.compact();
+    auto timeSnapshot = duration_cast<microseconds>(steady_clock::now() - start).count();
+    bool ok = last->csr.m == graph.edgeCount() && last->csr.n == graph.vertexCount() &&
+              last->epoch == graph.version();
+    for (int v = 0; v < last->csr.n && ok; ++v) ok = last->csr.view().degree(v) == graph.degree(v);
+
+    cout << "n = " << graph.vertexCount() << ", m = " << graph.edgeCount() << ", aktualizacje: " << updates << "\n";
+    cout << "Aktualizacje: " << timeUpdates << " µs (" << (timeUpdates ? updates * 1000000LL / timeUpdates : 0)
+         << " / s), przebiegi czytelnika na migawkach: " << passes << "\n";
+    cout << "Migawka CSR: " << timeSnapshot << " µs; przebudowa przy każdej zmianie kosztowałaby ok. "
+         << timeSnapshot * updates / 1000 << " ms, zgodność migawki: " << (ok ? "TAK" : "NIE") << "\n";
+}
+
+// Pokrycie śladami losowego rzadkiego grafu: sprawdza, że każda krawędź jest użyta dokładnie
+// raz, a śladów jest tyle, ile wynosi dolna granica (suma max(1, nieparzyste / 2) po składowych)
+void trailCoverDemo(int n, double avgDegree, unsigned threads, const string& outputFile) {
+    CsrGraph c = randomSparseCsr(n, avgDegree, 5);
+    CsrView g = c.view();
+    ofstream out;
+    if (!outputFile.empty()) out.open(outputFile);
+
+    unordered_map<long long, int> left;
+    for (int u = 0; u < g.n; ++u)
+        for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i)
+            ++left[(long long)min(u, g.target[i]) * g.n + max(u, g.target[i])];
+    bool valid = true;
+    long long edgesCovered = 0;
+
+    auto start = steady_clock::now();
+    long long trails = minimumTrailCover(g, [&](const vector<int>& trail) {
+        for (size_t i = 0; i + 1 < trail.size(); ++i) {
+            auto it = left.find((long long)min(trail[i], trail[i + 1]) * g.n + max(trail[i], trail[i + 1]));
+            if (it == left.end() || it->second < 2) valid = false;
+            else it->second -= 2;
+        }
+        edgesCovered += (long long)trail.size() - 1;
+        if (out) {
+            for (int v : trail) out << v << ' ';
+            out << '\n';
+        }
+    }, threads);
+    auto time = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+    vector<int> labels = connectedComponents(g, threads);
+    unordered_map<int, long long> odd;
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) > 0) odd[labels[v]] += g.degree(v) & 1;
+    long long lowerBound = 0;
+    for (auto& component : odd) lowerBound += max(1LL, component.second / 2);
+
+    cout << "n = " << g.n << ", m = " << g.m << ", składowe z krawędziami: " << odd.size() << "\n";
+    cout << "Śladów: " << trails << " (dolna granica " << lowerBound << "), podniesień pisaka: "
+         << trails - (long long)odd.size() << ", czas " << time << " ms, pokrycie: "
+         << (valid && edgesCovered == g.m && trails == lowerBound ? "poprawne" : "BŁĘDNE") << "\n";
+}
+
+// Szybkie ścieżki Hamiltona na grafach z rozpoznawalnych klas w porównaniu z przeszukiwaniem
+void graphClassesDemo(int n, unsigned seed) {
+    vector<pair<string, CsrGraph>> graphs;
+    graphs.push_back({ "przedziały jednostkowe", unitIntervalGraph(n, 8, seed) });
+    graphs.push_back({ "przedziały, rzadkie", unitIntervalGraph(n, 5, seed) });
+    // kograf i graf wielodzielny są gęste, więc mniejsze
+    int dense = min(n, 3000), side = dense / 4;
+    graphs.push_back({ "kograf", randomCograph(dense, 0.5, seed) });
+    graphs.push_back({ "pełny wielodzielny", completeMultipartite({ 2 * side, side, side }) });
+    graphs.push_back({ "pełny wielodzielny, za duża część", completeMultipartite({ 2 * side + 1, side, side - 1 }) });
+    graphs.push_back({ "losowy rzadki", randomSparseCsr(n, 6, seed) });
+
+    for (auto& entry : graphs) {
+        CsrView g = entry.second.view();
+        vector<int> path;
+        SolveStatus s = SolveStatus::NotFound;
+        auto start = steady_clock::now();
+        GraphClass c = hamiltonFastPath(g, path, s);
+        auto timeFast = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << entry.first << " (n = " << g.n << ", m = " << g.m << "): klasa " << graphClassName(c);
+        if (c != GraphClass::General)
+            cout << ", " << (s == SolveStatus::Found ? "cykl znaleziony" : "brak cyklu")
+                 << (s == SolveStatus::Found && !verifyHamiltonCycle(g, path)
+                     ? " (BŁĘDNY CERTYFIKAT)" : "");
+        cout << " w " << timeFast << " µs\n";
+
+        // HamiltonSearch ma jawny stos, więc głębokość n nie grozi przepełnieniem stosu wywołań
+        HamiltonSearch search(g);
+        start = steady_clock::now();
+        while (!search.resume(1 << 16) && steady_clock::now() - start < seconds(5)) {}
+        auto timePlain = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << "  przeszukiwanie: " << (!search.done() ? "przerwano po 5 s"
+                                         : search.status() == SolveStatus::Found ? "cykl znaleziony" : "brak cyklu")
+             << " w " << timePlain << " µs\n";
+    }
+}
+
+// SAT z leniwymi klauzulami podcykli kontra DFS na losowych grafach 3-regularnych
+void satDemo(int n, int graphs, unsigned seed) {
+    for (int i = 0; i < graphs; ++i) {
+        CsrGraph c = randomCubicGraph(n, seed + i);
+        CsrView g = c.view();
+        auto run = [&](const char* name, function<SolveStatus(vector<int>&, SearchControl*)> solve) {
+            SearchControl control;
+            control.deadline = steady_clock::now() + seconds(10);
+            vector<int> path;
+            auto start = steady_clock::now();
+            SolveStatus s = solve(path, &control);
+            auto time = duration_cast<milliseconds>(steady_clock::now() - start).count();
+            cout << "  " << name << ": " << (s == SolveStatus::Found ? "cykl znaleziony"
+                                              : s == SolveStatus::Aborted ? "przerwano po 10 s" : "brak cyklu")
+                 << (s == SolveStatus::Found && !verifyHamiltonCycle(g, path) ? " (BŁĘDNY CERTYFIKAT)" : "")
+                 << " w " << time << " ms\n";
+        };
+        cout << "Graf " << i + 1 << " (n = " << g.n << ", m = " << g.m << ")\n";
+        run("SAT", [&](vector<int>& path, SearchControl* control) { return satHamilton(g, path, control); });
+        run("DFS", [&](vector<int>& path, SearchControl* control) { return csrHamilton(g, path, control); });
+    }
+}
+
+// Sumy wyznaczników kontra DFS: graf ogólny (2^n podzbiorów etykiet) i dwudzielna siatka 4 x n/4 (2^(n/2))
+void algebraicDemo(int n, unsigned threads) {
+    vector<pair<string, CsrGraph>> graphs;
+    // wariant ogólny to 2^n wyznaczników, więc jego graf jest mniejszy
+    graphs.push_back({ "losowy 3-regularny", randomCubicGraph(min(n, 18) & ~1, 1) });
+    vector<pair<int, int>> grid;
+    int cols = max(n / 4, 2);
+    for (int v = 0; v < 4 * cols; ++v) {
+        if (v % cols + 1 < cols) grid.push_back({ v, v + 1 });
+        if (v + cols < 4 * cols) grid.push_back({ v, v + cols });
+    }
+    graphs.push_back({ "siatka 4 x " + to_string(cols), CsrGraph::fromEdges(4 * cols, grid) });
+    vector<pair<int, int>> petersen;
+    for (int i = 0; i < 5; ++i) {
+        petersen.push_back({ i, (i + 1) % 5 });
+        petersen.push_back({ i, i + 5 });
+        petersen.push_back({ i + 5, (i + 2) % 5 + 5 });
+    }
+    graphs.push_back({ "Petersen", CsrGraph::fromEdges(10, petersen) });
+
+    for (auto& entry : graphs) {
+        CsrView g = entry.second.view();
+        SearchControl control;
+        control.deadline = steady_clock::now() + seconds(60);
+        auto start = steady_clock::now();
+        SolveStatus s = algebraicHamilton(g, threads, &control);
+        auto timeAlgebraic = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        vector<int> path;
+        SearchControl dfsControl;
+        dfsControl.deadline = steady_clock::now() + seconds(60);
+        start = steady_clock::now();
+        SolveStatus d = csrHamilton(g, path, &dfsControl);
+        auto timeDfs = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        auto text = [](SolveStatus x) {
+            return x == SolveStatus::Found ? "jest cykl" : x == SolveStatus::Aborted ? "przerwano po 60 s" : "brak cyklu";
+        };
+        cout << entry.first << " (n = " << g.n << ", m = " << g.m << "): sumy wyznaczników " << text(s) << " w "
+             << timeAlgebraic << " ms, DFS " << text(d) << " w " << timeDfs << " ms\n";
+    }
+}
+
+// Ścieżka o k wierzchołkach w losowym rzadkim grafie: pełny silnik i samo sito wąskie
+void kPathDemo(int n, double avgDegree, int k, unsigned threads) {
+    CsrGraph c = randomSparseCsr(n, avgDegree, 3);
+    CsrView g = c.view();
+    cout << "n = " << g.n << ", m = " << g.m << ", k = " << k << "\n";
+    for (int dfs = 1; dfs >= 0; --dfs) {
+        SearchControl control;
+        control.deadline = steady_clock::now() + seconds(60);
+        vector<int> path;
+        auto start = steady_clock::now();
+        SolveStatus s = kPath(g, k, path, threads, dfs ? 64 : 0, &control, dfs ? 1 << 20 : 0);
+        auto time = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        bool valid = (int)path.size() == k;
+        vector<char> seen(g.n, 0);
+        for (size_t i = 0; valid && i < path.size(); ++i) {
+            valid = !seen[path[i]];
+            seen[path[i]] = 1;
+            if (valid && i + 1 < path.size()) {
+                const int* begin = g.target + g.offset[path[i]];
+                const int* end = g.target + g.offset[path[i] + 1];
+                valid = find(begin, end, path[i + 1]) != end;
             }
         }
+        cout << (dfs ? "DFS + kolory + sito: " : "Samo sito: ")
+             << (s == SolveStatus::Found ? (valid ? "ścieżka znaleziona" : "BŁĘDNA ŚCIEŻKA")
+                 : s == SolveStatus::Aborted ? "przerwano" : "brak ścieżki")
+             << " w " << time << " ms\n";
+    }
+}
+
+// Tablice dla małych grafów: czas budowy (albo wczytania), liczba grafów etykietowanych z cyklem
+// Hamiltona (dla n = 3..8: 1, 10, 218, 10078, 896756, 151676112)
+// i czas zapytania z tablicy wobec przeszukiwania z nawrotami na tych samych losowych grafach
+void tinyTablesDemo(int maxN, const string& cachePrefix) {
+    TinyHamiltonTables& tables = TinyHamiltonTables::current();
+    tables.configure(maxN, cachePrefix);
+    cout << "     n      grafy  z cyklem  ze ścieżką  tablica [ms]  tablica [ns/graf]  nawroty [ns/graf]\n";
+    for (int n = 3; n <= tables.maxVertices(); ++n) {
+        auto start = steady_clock::now();
+        tables.hasCycle(n, 0);
+        auto built = duration_cast<microseconds>(steady_clock::now() - start).count();
+        uint64_t graphs = 1ULL << (n * (n - 1) / 2);
+        long long cycles = 0, paths = 0;
+        for (uint64_t mask = 0; mask < graphs; ++mask) {
+            cycles += tables.hasCycle(n, mask);
+            paths += tables.hasPath(n, mask);
+        }
+
+        mt19937_64 gen(n);
+        vector<CsrGraph> sample;
+        for (int i = 0; i < 2000; ++i) {
+            uint64_t mask = gen() & (graphs - 1);
+            vector<pair<int, int>> edges;
+            for (int v = 1; v < n; ++v)
+                for (int u = 0; u < v; ++u)
+                    if (mask >> pairBit(u, v) & 1) edges.push_back({ u, v });
+            sample.push_back(CsrGraph::fromEdges(n, edges));
+        }
+        vector<int> path;
+        long long agree = 0;
+        start = steady_clock::now();
+        for (auto& c : sample) agree += tinyHamilton(c.view(), path) == SolveStatus::Found;
+        double lookup = duration_cast<nanoseconds>(steady_clock::now() - start).count() / (double)sample.size();
+        // csrHamiltonFrom z prefiksem {0} omija liść z tablicą
+        start = steady_clock::now();
+        for (auto& c : sample) agree -= csrHamiltonFrom(c.view(), { 0 }, path) == SolveStatus::Found;
+        double search = duration_cast<nanoseconds>(steady_clock::now() - start).count() / (double)sample.size();
+
+        cout << setw(6) << n << setw(11) << graphs << setw(10) << cycles << setw(12) << paths << setw(14)
+             << built / 1000.0 << setw(19) << (long long)lookup << setw(19) << (long long)search
+             << (agree ? "  (NIEZGODNOŚĆ Z PRZESZUKIWANIEM)" : "") << "\n";
+    }
+}
+
+// Generatory przestrzenne: rozmiar, stopień, spójność i długość sieci, czas generowania na
+// jednym wątku i na wszystkich oraz sprawdzenie, że oba przebiegi dały ten sam graf
+void spatialDemo(int n, double avgDegree, unsigned threads) {
+    threads = defaultThreads(threads);
+    vector<pair<string, function<SpatialGraph(unsigned)>>> generators = {
+        { "losowy geometryczny", [&](unsigned t) { return randomGeometricGraph(n, avgDegree, 1, true, t); } },
+        { "triangulacja", [&](unsigned t) { return delaunayLikeTriangulation(n, 2, true, t); } },
+        { "siatka ulic", [&](unsigned t) { return perturbedGrid(n, 0.3, 0.1, 3, true, t); } },
+    };
+    cout << "Wątki: " << threads << "\n";
+    for (auto& gen : generators) {
+        auto start = steady_clock::now();
+        SpatialGraph serial = gen.second(1);
+        auto timeSerial = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        start = steady_clock::now();
+        SpatialGraph parallel = gen.second(threads);
+        auto timeParallel = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        bool same = serial.graph.offset == parallel.graph.offset && serial.graph.target == parallel.graph.target &&
+                    serial.x == parallel.x && serial.y == parallel.y && serial.weight == parallel.weight;
+
+        const CsrView g = parallel.graph.view();
+        vector<int> labels = connectedComponents(g, threads), size(g.n, 0);
+        for (int v = 0; v < g.n; ++v) ++size[labels[v]];
+        double length = 0;
+        for (double w : parallel.weight) length += w;
+        cout << gen.first << ": n = " << g.n << ", m = " << g.m << ", średni stopień = " << 2.0 * g.m / max(g.n, 1)
+             << ", składowe: " << componentCount(labels) << " (największa "
+             << 100.0 * (g.n ? *max_element(size.begin(), size.end()) : 0) / max(g.n, 1) << "%)"
+             << ", długość sieci = " << length << "\n";
+        cout << "  generowanie: " << timeSerial << " ms na 1 wątku, " << timeParallel << " ms na " << threads
+             << (same ? ", wynik identyczny" : ", RÓŻNE WYNIKI") << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark skalowania wątków
+// ---------------------------------------------------------------------------
+
+// Silnik równoległy w benchmarku: prepare(skala) buduje wejście poza pomiarem (skala p = p razy
+// więcej pracy niż bazowo), run(wątki) to mierzony przebieg
+struct ScalingCase {
+    string name;
+    function<void(double)> prepare;
+    function<void(unsigned)> run;
+};
+
+// Kwantyl 0,975 rozkładu t-Studenta dla df stopni swobody (przedział ufności 95%)
+double studentT(int df) {
+    static const double table[] = { 12.71, 4.30, 3.18, 2.78, 2.57, 2.45, 2.36, 2.31, 2.26, 2.23,
+                                    2.20, 2.18, 2.16, 2.14, 2.13, 2.12, 2.11, 2.10, 2.09, 2.09 };
+    return df <= 0 ? 0 : df <= 20 ? table[df - 1] : df <= 30 ? 2.05 : 1.96;
+}
+
+// Każdy silnik dla 1, 2, 4, ... wątków (i maxThreads): skalowanie silne - to samo wejście,
+// słabe - wejście rosnące z liczbą wątków. Czas: średnia z repeats przebiegów z 95% przedziałem
+// ufności; przyspieszenie i efektywność względem jednego wątku; kradzieże i bezczynność
+// z liczników parallelFor (tylko czas wewnątrz pętli równoległych)
+void scalingBenchmark(int n, int repeats, unsigned maxThreads) {
+    maxThreads = defaultThreads(maxThreads);
+    vector<unsigned> counts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    CsrGraph graph, forest, bipartite;
+    vector<CsrGraph> batch;
+    vector<ScalingCase> cases;
+    cases.push_back({ "składowe (Afforest)", [&](double scale) { graph = randomSparseCsr((int)(n * scale), 4, 1); },
+                      [&](unsigned t) { connectedComponents(graph.view(), t); } });
+    cases.push_back({ "BFS z optymalizacją kierunku", [&](double scale) { graph = randomSparseCsr((int)(n * scale), 4, 1); },
+                      [&](unsigned t) { directionOptimizingBfs(graph.view(), 0, t); } });
+    cases.push_back({ "pokrycie śladami", [&](double scale) { forest = randomSparseCsr((int)(n * scale), 1.2, 2); },
+                      [&](unsigned t) { minimumTrailCover(forest.view(), [](const vector<int>&) {}, t); } });
+    // Partia niezależnych zapytań o nierównym koszcie: tu liczą się kradzieże
+    cases.push_back({ "Hamilton, partia zapytań", [&](double scale) {
+        batch.clear();
+        for (int i = 0; i < (int)(64 * scale); ++i) batch.push_back(randomSparseCsr(20, 6, 100 + i));
+    }, [&](unsigned t) {
+        parallelFor(0, (long long)batch.size(), t, [&](long long lo, long long hi) {
+            vector<int> path;
+            for (long long i = lo; i < hi; ++i) kernelizedHamilton(batch[(size_t)i].view(), path);
+        }, 1);
+    } });
+    // Koszt 2^h: słabe skalowanie dokłada log2(p) wierzchołków po każdej stronie
+    cases.push_back({ "Hamilton algebraiczny", [&](double scale) {
+        int h = 10 + (int)lround(log2(scale));
+        mt19937 gen(3);
+        vector<int> match(h);
+        vector<pair<int, int>> edges;
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < h; ++i) match[i] = i;
+            shuffle(match.begin(), match.end(), gen);
+            for (int i = 0; i < h; ++i) edges.push_back({ i, h + match[i] });
+        }
+        bipartite = CsrGraph::fromEdges(2 * h, edges);
+    }, [&](unsigned t) { algebraicHamilton(bipartite.view(), t); } });
 
-        for (int u : adj[v]) {
-            if (!visited[u]) {
-                if (hamiltonUtil(u, visited, path, depth + 1))
-                    return true;
+    ParallelStats stats;
+    bool numa = NumaTopology::current().nodes() > 1;
+    cout << "Wątki sprzętowe: " << thread::hardware_concurrency() << ", węzły NUMA: "
+         << NumaTopology::current().nodes() << ", powtórzenia: " << repeats << "\n";
+    cout << fixed;
+    for (auto& c : cases) {
+        for (int weak = 0; weak < 2; ++weak) {
+            cout << "\n" << c.name << ", skalowanie " << (weak ? "słabe" : "silne") << " (n = " << n << ")\n";
+            cout << " wątki    czas [ms] ± 95%     przyspieszenie  efektywność  nierównowaga  bezczynność";
+            cout << (numa ? "  kradzieże NUMA\n" : "\n");
+            if (!weak) c.prepare(1);
+            double base = 0;
+            for (unsigned t : counts) {
+                if (weak) c.prepare(t);
+                c.run(t);  // rozgrzewka: strony, pamięć podręczna
+                vector<double> times;
+                stats.reset();
+                parallelStatsSink() = &stats;
+                for (int r = 0; r < repeats; ++r) {
+                    auto start = steady_clock::now();
+                    c.run(t);
+                    times.push_back(duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0);
+                }
+                parallelStatsSink() = nullptr;
+                double mean = 0, variance = 0;
+                for (double x : times) mean += x;
+                mean /= repeats;
+                for (double x : times) variance += (x - mean) * (x - mean);
+                double half = repeats > 1 ? studentT(repeats - 1) * sqrt(variance / (repeats - 1) / repeats) : 0;
+                if (t == 1) base = mean;
+                double speedup = base / mean, efficiency = weak ? speedup : speedup / t;
+                // max / średnia czasu pracy wątku; kradzieże tylko między węzłami NUMA
+                double imbalance = stats.meanBusyNs ? (double)stats.peakBusyNs / stats.meanBusyNs : 1;
+                double stolen = stats.chunks ? 100.0 * stats.stolen / stats.chunks : 0;
+                double idle = stats.availableNs ? 100.0 * (1 - (double)stats.busyNs / stats.availableNs) : 0;
+                cout << setw(6) << t << setw(11) << setprecision(2) << mean << " ± " << setw(8) << left << half
+                     << right << setw(12) << speedup << setw(13) << setprecision(0) << efficiency * 100 << "%"
+                     << setw(13) << setprecision(2) << imbalance << "x" << setw(12) << setprecision(1)
+                     << max(0.0, idle) << "%";
+                if (numa) cout << setw(15) << stolen << "%";
+                cout << "\n";
             }
         }
+    }
+    cout.unsetf(ios::fixed);
+}
 
-        visited[v] = false;
-        path.pop_back();
-        return false;
+// ---------------------------------------------------------------------------
+// Generator obciążenia: zamknięta pętla, histogramy opóźnień, percentyle dla SLO
+// ---------------------------------------------------------------------------
+
+// Histogram w stylu HDR: przedziały liniowe wewnątrz każdej potęgi dwójki (2^subBits na potęgę),
+// więc błąd względny wartości < 2^-subBits przy stałym rozmiarze niezależnym od zakresu
+class LatencyHistogram {
+public:
+    static const int subBits = 7;
+
+    LatencyHistogram() : counts((64 - subBits + 1) << subBits, 0) {}
+
+    void record(long long value) {
+        ++counts[index(max(0LL, value))];
+        ++total;
+        largest = max(largest, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+        largest = max(largest, other.largest);
+    }
+
+    // Najmniejsza wartość v (z dokładnością przedziału), że co najmniej q zapisów <= v
+    long long percentile(double q) const {
+        long long need = max(1LL, (long long)ceil(q * total)), seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= need) return min(largest, highest(i));
+        }
+        return largest;
+    }
+
+    long long count() const { return total; }
+    long long maximum() const { return largest; }
+
+private:
+    static size_t index(long long v) {
+        int top = 63;
+        while (top > 0 && !(v >> top)) --top;
+        int shift = max(0, top - subBits);
+        if (shift == 0) return (size_t)v;
+        return ((size_t)(shift + 1) << subBits) + (size_t)((v >> shift) - (1LL << subBits));
     }
 
-    bool hamilton(vector<int>& path) {
-        vector<bool> visited(n, false);
-        return hamiltonUtil(0, visited, path, 1);
+    static long long highest(size_t i) {
+        if (i < (2u << subBits)) return (long long)i;
+        int shift = (int)(i >> subBits) - 1;
+        return ((((long long)(i & ((1u << subBits) - 1)) + (1LL << subBits)) << shift)) + (1LL << shift) - 1;
     }
+
+    vector<long long> counts;
+    long long total = 0, largest = 0;
+};
+
+// Składnik mieszanki zapytań: graf generateGraph(n, gęstość), operacja i waga losowania
+struct LoadMix {
+    int n;
+    double density;
+    uint8_t op;
+    int weight;
 };
 
+// Dla współbieżności 1, 2, 4, ..., maxConcurrency: tyle wątków klientów w zamkniętej pętli
+// (następne zapytanie dopiero po odpowiedzi). Przy qps > 0 każdy klient ma harmonogram co
+// współbieżność/qps i opóźnienie liczy się od planowanego startu, więc kolejka przed klientem
+// (koordynowane pominięcie) trafia do percentyli. Cel: solwery w procesie albo demon na gnieździe
+int loadBenchmark(double secondsPerLevel, double qps, int maxConcurrency, const string& socketPath) {
+    const vector<LoadMix> mix = { { 30, 20, OpHamilton, 4 }, { 60, 10, OpHamilton, 2 },
+                                  { 200, 5, OpHamilton, 1 }, { 2000, 1, OpEuler, 3 } };
+    const uint32_t deadlineMs = 100;
+    vector<CsrGraph> graphs;
+    vector<uint32_t> ids;
+    for (auto& item : mix) graphs.push_back(CsrGraph::fromGraph(Graph::generateGraph(item.n, item.density)));
+
+    // Demon wczytuje te same grafy z plików roboczych w katalogu bieżącym (ścieżki względne, więc
+    // demon musi działać w tym samym katalogu); numery grafów są wspólne dla połączeń
+    auto connectDaemon = [&] {
+        socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = unixAddress(socketPath);
+        if (s != invalidSocket && connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            closeSocket(s);
+            s = invalidSocket;
+        }
+        return s;
+    };
+    auto call = [](socket_t s, const DaemonRequest& req, const string& extra, DaemonResponse& res, vector<int>& out) {
+        if (!sendAll(s, &req, sizeof(req)) || !sendAll(s, extra.data(), extra.size())) return false;
+        if (!recvAll(s, &res, sizeof(res))) return false;
+        out.resize(res.count);
+        return recvAll(s, out.data(), out.size() * sizeof(int));
+    };
+    vector<string> files;
+    if (!socketPath.empty()) {
+        socket_t s = connectDaemon();
+        if (s == invalidSocket) {
+            cout << "Nie można połączyć się z " << socketPath << "\n";
+            return 1;
+        }
+        for (size_t i = 0; i < graphs.size(); ++i) {
+            files.push_back("load-" + to_string(i) + ".csrg");
+            DaemonRequest req;
+            memset(&req, 0, sizeof(req));
+            req.op = OpLoad;
+            req.pathLength = (uint16_t)files.back().size();
+            DaemonResponse res;
+            vector<int> out;
+            if (!saveGraphFile(graphs[i], files.back()) || !call(s, req, files.back(), res, out) || res.status != StatusOk) {
+                cout << "Demon nie wczytał grafu " << files.back() << "\n";
+                closeSocket(s);
+                return 1;
+            }
+            ids.push_back(res.value);
+        }
+        closeSocket(s);
+    }
+
+    vector<int> picks;
+    for (size_t i = 0; i < mix.size(); ++i) picks.insert(picks.end(), mix[i].weight, (int)i);
+
+    cout << "Cel: " << (socketPath.empty() ? "solwery w procesie" : "demon " + socketPath)
+         << ", QPS: " << (qps > 0 ? to_string((long long)qps) : string("bez limitu"))
+         << ", termin Hamiltona: " << deadlineMs << " ms, " << secondsPerLevel << " s na poziom\n";
+    cout << "współbieżność  zapytania  przepustowość [1/s]    p50 [ms]    p99 [ms]  p99.9 [ms]    max [ms]  terminy  błędy\n";
+    cout << fixed;
+    bool ok = true;
+    for (int concurrency = 1;; concurrency = min(concurrency * 2, maxConcurrency)) {
+        vector<LatencyHistogram> histograms(concurrency);
+        atomic<long long> timeouts{ 0 }, errors{ 0 };
+        auto begin = steady_clock::now() + milliseconds(10);
+        auto end = begin + duration_cast<steady_clock::duration>(duration<double>(secondsPerLevel));
+        auto interval = qps > 0 ? duration_cast<steady_clock::duration>(duration<double>(concurrency / qps))
+                                : steady_clock::duration::zero();
 
+        auto client = [&](int w) {
+            socket_t s = socketPath.empty() ? invalidSocket : connectDaemon();
+            if (!socketPath.empty() && s == invalidSocket) {
+                ++errors;
+                return;
+            }
+            mt19937 gen(1000 + w);
+            uniform_int_distribution<size_t> pick(0, picks.size() - 1);
+            vector<int> out;
+            // Klienci przesunięci o ułamek odstępu, żeby nie startowali jednocześnie
+            auto planned = begin + interval * w / concurrency;
+            while (planned < end) {
+                this_thread::sleep_until(planned);
+                auto sent = steady_clock::now();
+                if (sent >= end) break;
+                int item = picks[pick(gen)];
+                uint8_t status = StatusOk;
+                if (s != invalidSocket) {
+                    DaemonRequest req;
+                    memset(&req, 0, sizeof(req));
+                    req.op = mix[item].op;
+                    req.graphId = ids[item];
+                    req.deadlineMs = mix[item].op == OpHamilton ? deadlineMs : 0;
+                    DaemonResponse res;
+                    status = call(s, req, "", res, out) ? res.status : (uint8_t)StatusBadRequest;
+                } else if (mix[item].op == OpEuler) {
+                    out = csrEuler(graphs[item].view(), 0);
+                } else {
+                    SearchControl control;
+                    control.deadline = sent + milliseconds(deadlineMs);
+                    SolveStatus r = classifiedHamilton(graphs[item].view(), out, &control);
+                    status = r == SolveStatus::Aborted ? StatusTimeout : r == SolveStatus::Found ? StatusOk : StatusNoCycle;
+                }
+                auto done = steady_clock::now();
+                if (status == StatusTimeout) ++timeouts;
+                if (status == StatusBadRequest) ++errors;
+                histograms[w].record(duration_cast<nanoseconds>(done - (qps > 0 ? planned : sent)).count());
+                planned = qps > 0 ? planned + interval : done;
+            }
+            if (s != invalidSocket) closeSocket(s);
+        };
+        vector<thread> clients;
+        for (int w = 0; w < concurrency; ++w) clients.emplace_back(client, w);
+        for (auto& c : clients) c.join();
+        auto elapsed = duration<double>(steady_clock::now() - begin).count();
+
+        LatencyHistogram all;
+        for (auto& h : histograms) all.merge(h);
+        auto ms = [](long long ns) { return ns / 1e6; };
+        cout << setw(13) << concurrency << setw(11) << all.count() << setw(21) << setprecision(1)
+             << all.count() / max(elapsed, 1e-9) << setprecision(3) << setw(12) << ms(all.percentile(0.5))
+             << setw(12) << ms(all.percentile(0.99)) << setw(12) << ms(all.percentile(0.999))
+             << setw(12) << ms(all.maximum()) << setw(9) << timeouts << setw(7) << errors << "\n";
+        ok = ok && errors == 0;
+        if (concurrency >= maxConcurrency) break;
+    }
+    cout.unsetf(ios::fixed);
+    for (auto& f : files) remove(f.c_str());
+    return ok ? 0 : 1;
+}
 
 void test(int n, double density) {
     cout << "Test dla n = " << n << ", gęstość = " << density << "%\n";
@@ -138,7 +2865,274 @@ void test(int n, double density) {
 }
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Tryb weryfikacji: ConsoleApplication23 verify [rundy] [ziarno]
+    if (argc > 1 && string(argv[1]) == "verify") {
+        int rounds = argc > 2 ? stoi(argv[2]) : 500;
+        unsigned seed = argc > 3 ? (unsigned)stoul(argv[3]) : random_device{}();
+        cout << "Testy różnicowe, ziarno = " << seed << "\n";
+        registerEngines();
+        return differentialTest(rounds, seed) ? 0 : 1;
+    }
+
+    // Zapis wygenerowanego grafu do pliku CSR: save <n> <gęstość> <plik>
+    if (argc > 4 && string(argv[1]) == "save") {
+        Graph g = Graph::generateGraph(stoi(argv[2]), stod(argv[3]));
+        return saveGraphFile(CsrGraph::fromGraph(g), argv[4]) ? 0 : 1;
+    }
+
+    // Pamięć współdzielona: shm-publish <nazwa> <n> <gęstość> trzyma segment do końca wejścia,
+    // shm-attach <nazwa> dołącza tylko do odczytu i rozwiązuje na prywatnym stanie
+    if (argc > 4 && string(argv[1]) == "shm-publish") {
+        SharedSegment segment;
+        Graph g = Graph::generateGraph(stoi(argv[3]), stod(argv[4]));
+        if (!publishSharedGraph(segment, argv[2], g)) {
+            cout << "Nie można utworzyć segmentu " << argv[2] << "\n";
+            return 1;
+        }
+        cout << "Segment " << argv[2] << " gotowy (" << segment.size() << " B), Enter kończy\n";
+        string line;
+        getline(cin, line);
+        return 0;
+    }
+    if (argc > 2 && string(argv[1]) == "shm-attach") {
+        auto start = steady_clock::now();
+        ResidentGraph g;
+        if (!g.load(string("shm:") + argv[2])) {
+            cout << "Brak segmentu " << argv[2] << " albo niepoprawny graf\n";
+            return 1;
+        }
+        auto attached = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << "Dołączono w " << attached << " µs: n = " << g.view.n << ", m = " << g.view.m << "\n";
+        vector<int> path;
+        SolveStatus s = csrHamilton(g.view, path, nullptr, g.adjacency.get());
+        // csrEuler zaczyna od wierzchołka 0, więc pusty segment i graf nieeulerowski idą osobno
+        if (g.view.n > 0 && g.eulerian)
+            cout << "Cykl Eulera: " << csrEuler(g.view, 0).size() << " wierzchołków";
+        else
+            cout << "Cykl Eulera: brak (graf nie jest eulerowski)";
+        cout << ", cykl Hamiltona " << (s == SolveStatus::Found ? "znaleziony" : "nie znaleziony") << "\n";
+        return 0;
+    }
+
+    // Potok asynchroniczny: async [grafy] [n] [gęstość]
+    if (argc > 1 && string(argv[1]) == "async") {
+        asyncDemo(argc > 2 ? stoi(argv[2]) : 64, argc > 3 ? stoi(argv[3]) : 200,
+                  argc > 4 ? stod(argv[4]) : 30.0);
+        return 0;
+    }
+
+    // Spójność dużych grafów: components <n> <średni stopień> [wątki]
+    if (argc > 3 && string(argv[1]) == "components") {
+        unsigned threads = argc > 4 ? (unsigned)stoul(argv[4]) : 0;
+        CsrGraph c = randomSparseCsr(stoi(argv[2]), stod(argv[3]), 1);
+        auto start = steady_clock::now();
+        vector<int> labels = connectedComponents(c.view(), threads);
+        auto timeCc = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        start = steady_clock::now();
+        BfsResult bfs = directionOptimizingBfs(c.view(), 0, threads);
+        auto timeBfs = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        long long reached = count_if(bfs.parent.begin(), bfs.parent.end(), [](int p) { return p >= 0; });
+        cout << "n = " << c.n << ", m = " << c.m << ", wątki: " << defaultThreads(threads) << "\n";
+        cout << "Składowe spójności: " << componentCount(labels) << " (" << timeCc << " ms)\n";
+        cout << "BFS: osiągnięto " << reached << " wierzchołków, poziomy: " << bfs.levels
+             << ", bottom-up: " << bfs.bottomUpLevels << " (" << timeBfs << " ms)\n";
+        return 0;
+    }
+
+    // Postęp długiego przeszukiwania: progress <n> <gęstość> [odstęp ms] [plik statystyk]
+    if (argc > 3 && string(argv[1]) == "progress") {
+        progressDemo(stoi(argv[2]), stod(argv[3]), milliseconds(argc > 4 ? stoi(argv[4]) : 1000),
+                     argc > 5 ? argv[5] : "");
+        return 0;
+    }
+
+    // Kernelizacja: kernel <n> <średni stopień> [ziarno] - rzadki graf z cyklem bazowym
+    if (argc > 3 && string(argv[1]) == "kernel") {
+        int n = stoi(argv[2]);
+        mt19937 gen(argc > 4 ? (unsigned)stoul(argv[4]) : 1);
+        uniform_int_distribution<int> vertex(0, n - 1);
+        vector<pair<int, int>> edges;
+        for (int v = 0; v < n; ++v) edges.push_back({ v, (v + 1) % n });
+        for (long long e = 0; e < (long long)((stod(argv[3]) - 2) * n / 2); ++e) {
+            int u = vertex(gen), v = vertex(gen);
+            if (u != v) edges.push_back({ u, v });
+        }
+        CsrGraph c = CsrGraph::fromEdges(n, edges);
+        auto start = steady_clock::now();
+        HamiltonKernel k = kernelizeHamilton(c.view());
+        auto timeKernel = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << "Oryginał: n = " << c.n << ", m = " << c.m << "\n";
+        if (k.infeasible) cout << "Brak cyklu Hamiltona wykazany przez redukcję\n";
+        else if (!k.solved.empty()) cout << "Cykl wymuszony w całości przez redukcję\n";
+        else cout << "Jądro: n = " << k.reduced.n << ", m = " << k.reduced.m << "\n";
+        cout << "Wymuszone krawędzie: " << k.forcedEdges << ", usunięte: " << k.deletedEdges
+             << ", czas: " << timeKernel << " µs\n";
+        return 0;
+    }
+
+    // Klasy grafów z szybką ścieżką Hamiltona: classes <n> [ziarno]
+    if (argc > 2 && string(argv[1]) == "classes") {
+        graphClassesDemo(stoi(argv[2]), argc > 3 ? (unsigned)stoul(argv[3]) : 1);
+        return 0;
+    }
+
+    // Hamilton przez SAT: sat <n> [grafy] [ziarno]
+    if (argc > 2 && string(argv[1]) == "sat") {
+        satDemo(stoi(argv[2]), argc > 3 ? stoi(argv[3]) : 5, argc > 4 ? (unsigned)stoul(argv[4]) : 1);
+        return 0;
+    }
+
+    // Algebraiczny test Hamiltona: algebraic <n> [wątki]
+    if (argc > 2 && string(argv[1]) == "algebraic") {
+        algebraicDemo(stoi(argv[2]), argc > 3 ? (unsigned)stoul(argv[3]) : 0);
+        return 0;
+    }
+
+    // Ścieżka o k wierzchołkach: kpath <n> <średni stopień> <k> [wątki]
+    if (argc > 4 && string(argv[1]) == "kpath") {
+        kPathDemo(stoi(argv[2]), stod(argv[3]), stoi(argv[4]), argc > 5 ? (unsigned)stoul(argv[5]) : 0);
+        return 0;
+    }
+
+    // Skalowanie wątków: scaling <n> [powtórzenia] [maks. wątków]
+    if (argc > 2 && string(argv[1]) == "scaling") {
+        scalingBenchmark(stoi(argv[2]), argc > 3 ? stoi(argv[3]) : 5, argc > 4 ? (unsigned)stoul(argv[4]) : 0);
+        return 0;
+    }
+
+    // Obciążenie: load <sekundy na poziom> <qps, 0 = bez limitu> [maks. współbieżność] [gniazdo demona]
+    if (argc > 3 && string(argv[1]) == "load") {
+        SocketRuntime sockets;
+        return loadBenchmark(stod(argv[2]), stod(argv[3]), argc > 4 ? max(1, stoi(argv[4])) : 8, argc > 5 ? argv[5] : "");
+    }
+
+    // Tablice małych grafów: tiny [maks. n, do 8] [prefiks plików tablic]
+    if (argc > 1 && string(argv[1]) == "tiny") {
+        tinyTablesDemo(argc > 2 ? stoi(argv[2]) : 7, argc > 3 ? argv[3] : "");
+        return 0;
+    }
+
+    // Generatory przestrzenne: spatial <n> [średni stopień] [wątki]
+    if (argc > 2 && string(argv[1]) == "spatial") {
+        spatialDemo(stoi(argv[2]), argc > 3 ? stod(argv[3]) : 6, argc > 4 ? (unsigned)stoul(argv[4]) : 0);
+        return 0;
+    }
+
+    // Separatory: separator <bloki> <rozmiar bloku> [gęstość bloku %] [ziarno] [wątki]
+    if (argc > 3 && string(argv[1]) == "separator") {
+        CsrGraph c = necklaceGraph(stoi(argv[2]), stoi(argv[3]), argc > 4 ? stod(argv[4]) / 100 : 0.5,
+                                   argc > 5 ? (unsigned)stoul(argv[5]) : 1);
+        Graph g = c.toGraph();
+        vector<int> path;
+        auto start = steady_clock::now();
+        SolveStatus s = separatorHamilton(c.view(), path, nullptr, argc > 6 ? (unsigned)stoul(argv[6]) : 0);
+        auto timeSplit = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << "n = " << c.n << ", m = " << c.m << "\nPodział: "
+             << (s == SolveStatus::Found ? "cykl znaleziony" : "brak cyklu") << " w " << timeSplit << " µs"
+             << (s == SolveStatus::Found && !verifyHamiltonCycle(g, path) ? " (BŁĘDNY CERTYFIKAT)" : "") << "\n";
+        SearchControl control;
+        control.deadline = steady_clock::now() + seconds(10);
+        start = steady_clock::now();
+        s = csrHamilton(c.view(), path, &control);
+        auto timePlain = duration_cast<microseconds>(steady_clock::now() - start).count();
+        cout << "Bez podziału: " << (s == SolveStatus::Found ? "cykl znaleziony"
+                                     : s == SolveStatus::Aborted ? "przerwano po 10 s" : "brak cyklu")
+             << " w " << timePlain << " µs\n";
+        return 0;
+    }
+
+    // Sąsiedztwo hybrydowe: adjacency <n> <średni stopień> <huby> [zapytania]
+    if (argc > 4 && string(argv[1]) == "adjacency") {
+        adjacencyDemo(stoi(argv[2]), stod(argv[3]), stoi(argv[4]), argc > 5 ? stoi(argv[5]) : 200000);
+        return 0;
+    }
+
+    // Przeplatane przejścia Eulera: interleave <grafy> <n> [cykle na graf] [szerokość]
+    if (argc > 3 && string(argv[1]) == "interleave") {
+        interleaveDemo(stoi(argv[2]), stoi(argv[3]), argc > 4 ? stoi(argv[4]) : 2, argc > 5 ? stoi(argv[5]) : 8);
+        return 0;
+    }
+
+    // Rozmieszczenie NUMA i raport dostępów: numa <n> <średni stopień> [wątki]
+    if (argc > 3 && string(argv[1]) == "numa") {
+        numaDemo(stoi(argv[2]), stod(argv[3]), argc > 4 ? (unsigned)stoul(argv[4]) : 0);
+        return 0;
+    }
+
+    // Przeplatanie przeszukiwań: slices <zapytania> <n> <co które trudne> [kawałek węzłów] [wątki]
+    if (argc > 4 && string(argv[1]) == "slices") {
+        sliceDemo(stoi(argv[2]), stoi(argv[3]), stoi(argv[4]), argc > 5 ? stoll(argv[5]) : 4096,
+                  argc > 6 ? (unsigned)stoul(argv[6]) : 0);
+        return 0;
+    }
+
+    // Graf zmienny: dynamic <n> <średni stopień> <aktualizacje> [co ile ms migawka]
+    if (argc > 4 && string(argv[1]) == "dynamic") {
+        dynamicDemo(stoi(argv[2]), stod(argv[3]), stoi(argv[4]), milliseconds(argc > 5 ? stoi(argv[5]) : 100));
+        return 0;
+    }
+
+    // Najmniejsze pokrycie śladami: trails <n> <średni stopień> [wątki] [plik ze śladami]
+    if (argc > 3 && string(argv[1]) == "trails") {
+        trailCoverDemo(stoi(argv[2]), stod(argv[3]), argc > 4 ? (unsigned)stoul(argv[4]) : 0, argc > 5 ? argv[5] : "");
+        return 0;
+    }
+
+    // Demon: daemon <gniazdo> [wątki] [domyślny termin ms]; klient: client <gniazdo> <plik> [zapytania];
+    // stop <gniazdo>
+    if (argc > 2 && string(argv[1]) == "daemon") {
+        SocketRuntime sockets;
+        SolverDaemon daemon(argv[2], argc > 3 ? (unsigned)stoul(argv[3]) : 0, argc > 4 ? (uint32_t)stoul(argv[4]) : 30000);
+        return daemon.run() ? 0 : 1;
+    }
+    if (argc > 3 && string(argv[1]) == "client") {
+        SocketRuntime sockets;
+        return runClient(argv[2], argv[3], argc > 4 ? stoi(argv[4]) : 1000);
+    }
+    // Rozproszony Hamilton: coordinator <adres> <n> <gęstość> [kawałek ms]; worker <adres>;
+    // lokalnie z procesami robotników: dist-hamilton <n> <gęstość> <procesy> [kawałek ms]
+    if (argc > 4 && string(argv[1]) == "coordinator") {
+        SocketRuntime sockets;
+        Graph g = Graph::generateGraph(stoi(argv[3]), stod(argv[4]));
+        CsrGraph c = CsrGraph::fromGraph(g);
+        vector<int> cycle;
+        HamiltonCoordinator coordinator(c.view(), 64, argc > 5 ? stoi(argv[5]) : 200);
+        SolveStatus s = coordinator.run(argv[2], cycle);
+        cout << (s == SolveStatus::Found ? "Cykl znaleziony" : s == SolveStatus::Aborted ? "Błąd koordynatora" : "Brak cyklu")
+             << (s == SolveStatus::Found && !verifyHamiltonCycle(g, cycle) ? " (BŁĘDNY CERTYFIKAT)" : "") << "\n";
+        return s == SolveStatus::Aborted ? 1 : 0;
+    }
+    if (argc > 2 && string(argv[1]) == "worker") {
+        SocketRuntime sockets;
+        return runHamiltonWorker(argv[2]);
+    }
+    if (argc > 4 && string(argv[1]) == "dist-hamilton") {
+        SocketRuntime sockets;
+        return distributedDemo(argv[0], stoi(argv[2]), stod(argv[3]), stoi(argv[4]), argc > 5 ? stoi(argv[5]) : 200);
+    }
+    // Rozproszony Euler: euler-coordinator <adres> <n> <części>; euler-worker <adres> <graf> <prefiks>;
+    // lokalnie na sumie losowych cykli: dist-euler <n> <cykle> <procesy>
+    if (argc > 4 && string(argv[1]) == "euler-coordinator") {
+        SocketRuntime sockets;
+        int n = stoi(argv[3]), parts = stoi(argv[4]);
+        vector<long long> bounds;
+        for (int k = 0; k <= parts; ++k) bounds.push_back((long long)n * k / parts);
+        return runEulerCoordinator(argv[2], bounds);
+    }
+    if (argc > 4 && string(argv[1]) == "euler-worker") {
+        SocketRuntime sockets;
+        return runEulerWorker(argv[2], argv[3], argv[4]);
+    }
+    if (argc > 4 && string(argv[1]) == "dist-euler") {
+        SocketRuntime sockets;
+        return distributedEulerDemo(argv[0], stoi(argv[2]), stoi(argv[3]), stoi(argv[4]));
+    }
+    if (argc > 2 && string(argv[1]) == "stop") {
+        SocketRuntime sockets;
+        return stopDaemon(argv[2]);
+    }
+
     // Testy dla małych n, bo dla większych będzie długo
     for (int n = 5; n <= 65; n += 5) {
         test(n, 30.0);  // rzadki graf
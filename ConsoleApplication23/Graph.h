@@ -0,0 +1,3585 @@
+﻿#pragma once
+
+// Graf, reprezentacja CSR i silniki Eulera / Hamiltona - wspólne dla programu konsolowego i biblioteki GraphLib
+
+#include <vector>
+#include <set>
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#elif defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+
+class Graph {
+public:
+    int n;
+    vector<vector<int>> adj;
+    vector<vector<bool>> used;
+
+    Graph(int size) : n(size), adj(size), used(size, vector<bool>(size, false)) {}
+
+
+
+    void addEdge(int u, int v) {
+        adj[u].push_back(v);
+        adj[v].push_back(u);
+        used[u][v] = used[v][u] = false;
+    }
+
+    static Graph generateGraph(int n, double densityPercent) {
+        Graph g(n);
+        int maxEdges = n * (n - 1) / 2;
+        int edgeCount = (int)(densityPercent / 100.0 * maxEdges);
+
+        // Tworzymy spójny cykl bazowy (Hamilton i Euler)
+        for (int i = 0; i < n - 1; ++i)
+            g.addEdge(i, i + 1);
+        g.addEdge(n - 1, 0);
+
+        set<pair<int, int>> existingEdges;
+        for (int i = 0; i < n; ++i)
+            for (int j : g.adj[i])
+                if (i < j) existingEdges.insert({ i, j });
+
+        random_device rd;
+        mt19937 gen(rd());
+        uniform_int_distribution<> dist(0, n - 1);
+
+        while ((int)existingEdges.size() < edgeCount) {
+            int u = dist(gen), v = dist(gen);
+            if (u == v) continue;
+            pair<int, int> e = { min(u,v), max(u,v) };
+            if (existingEdges.count(e)) continue;
+            g.addEdge(u, v);
+            existingEdges.insert(e);
+        }
+
+        // Dopilnuj, żeby każdy wierzchołek miał parzysty stopień (Euler)
+        for (int i = 0; i < n; ++i) {
+            if (g.adj[i].size() % 2 != 0) {
+                int j = (i + 1) % n;
+                // Sprawdź, czy krawędź już istnieje, aby uniknąć duplikatu
+                pair<int, int> e = { min(i,j), max(i,j) };
+                if (existingEdges.count(e) == 0) {
+                    g.addEdge(i, j);
+                    existingEdges.insert(e);
+                }
+            }
+        }
+
+        return g;
+    }
+
+    void resetUsed() {
+        used = vector<vector<bool>>(n, vector<bool>(n, false));
+    }
+
+    void euler(int v, vector<int>& cycle) {
+        for (int u : adj[v]) {
+            if (!used[v][u]) {
+                used[v][u] = used[u][v] = true;
+                euler(u, cycle);
+            }
+        }
+        cycle.push_back(v);
+    }
+
+    bool hamiltonUtil(int v, vector<bool>& visited, vector<int>& path, int depth) {
+        path.push_back(v);
+        visited[v] = true;
+
+        if (depth == n) {
+            for (int u : adj[v]) {
+                if (u == path[0]) {
+                    path.push_back(path[0]);
+                    return true;
+                }
+            }
+        }
+
+        for (int u : adj[v]) {
+            if (!visited[u]) {
+                if (hamiltonUtil(u, visited, path, depth + 1))
+                    return true;
+            }
+        }
+
+        visited[v] = false;
+        path.pop_back();
+        return false;
+    }
+
+    bool hamilton(vector<int>& path) {
+        vector<bool> visited(n, false);
+        return hamiltonUtil(0, visited, path, 1);
+    }
+
+    long long edgeCount() const {
+        long long deg = 0;
+        for (const auto& a : adj) deg += (long long)a.size();
+        return deg / 2;
+    }
+
+    // Graf ma cykl Eulera: parzyste stopnie i wszystkie krawędzie w jednej składowej
+    bool isEulerian() const {
+        int start = -1;
+        for (int v = 0; v < n; ++v) {
+            if (adj[v].size() % 2 != 0) return false;
+            if (start < 0 && !adj[v].empty()) start = v;
+        }
+        if (start < 0) return true;
+        vector<bool> seen(n, false);
+        vector<int> stack = { start };
+        seen[start] = true;
+        while (!stack.empty()) {
+            int v = stack.back(); stack.pop_back();
+            for (int u : adj[v])
+                if (!seen[u]) { seen[u] = true; stack.push_back(u); }
+        }
+        for (int v = 0; v < n; ++v)
+            if (!adj[v].empty() && !seen[v]) return false;
+        return true;
+    }
+};
+
+// Graf w formacie CSR. Widok nie posiada pamięci - tablice mogą pochodzić z wektorów,
+// z pliku zmapowanego przez mmap albo z pamięci współdzielonej
+struct CsrView {
+    int n = 0;
+    long long m = 0;
+    const long long* offset = nullptr;  // n + 1 pozycji
+    const int* target = nullptr;        // 2m sąsiadów
+    const int* edgeId = nullptr;        // 2m numerów krawędzi (obie połówki mają ten sam)
+
+    int degree(int v) const { return (int)(offset[v + 1] - offset[v]); }
+};
+
+// Silniki CSR indeksują tablicami bez sprawdzania, więc widok z zewnątrz (plik, pamięć współdzielona,
+// bufor z API) trzeba raz przejrzeć w O(n + m), zanim ktokolwiek po nim przejdzie
+inline bool csrValid(const CsrView& g) {
+    if (g.n < 0 || g.m < 0 || !g.offset || (g.m > 0 && (!g.target || !g.edgeId))) return false;
+    if (g.offset[0] != 0 || g.offset[g.n] != 2 * g.m) return false;
+    for (int v = 0; v < g.n; ++v)
+        if (g.offset[v] > g.offset[v + 1]) return false;
+    for (long long i = 0; i < 2 * g.m; ++i)
+        if (g.target[i] < 0 || g.target[i] >= g.n || g.edgeId[i] < 0 || g.edgeId[i] >= g.m) return false;
+    return true;
+}
+
+struct CsrGraph {
+    int n = 0;
+    long long m = 0;
+    vector<long long> offset;
+    vector<int> target, edgeId;
+
+    CsrView view() const {
+        CsrView v;
+        v.n = n; v.m = m;
+        v.offset = offset.data(); v.target = target.data(); v.edgeId = edgeId.data();
+        return v;
+    }
+
+    // Zachowuje kolejność sąsiadów z adj, więc silniki CSR odwiedzają graf tak samo jak referencja
+    static CsrGraph fromGraph(const Graph& g) {
+        CsrGraph c;
+        c.n = g.n;
+        c.m = g.edgeCount();
+        c.offset.resize(g.n + 1);
+        c.target.resize((size_t)(2 * c.m));
+        c.edgeId.resize((size_t)(2 * c.m));
+        fill(g, c.offset.data(), c.target.data(), c.edgeId.data());
+        return c;
+    }
+
+    // Wypełnia tablice CSR o rozmiarach n + 1 i 2m w miejscu, np. prosto w pamięci współdzielonej
+    static void fill(const Graph& g, long long* offset, int* target, int* edgeId) {
+        offset[0] = 0;
+        for (int v = 0; v < g.n; ++v)
+            offset[v + 1] = offset[v] + (long long)g.adj[v].size();
+
+        // Obie połówki krawędzi dostają ten sam numer; krawędzie równoległe są nierozróżnialne,
+        // więc wystarczy parować je w dowolnej kolejności
+        unordered_map<long long, vector<int>> pending;
+        int next = 0;
+        for (int u = 0; u < g.n; ++u) {
+            int openLoop = -1;
+            for (size_t i = 0; i < g.adj[u].size(); ++i) {
+                int v = g.adj[u][i];
+                size_t pos = (size_t)offset[u] + i;
+                target[pos] = v;
+                if (u < v) {
+                    edgeId[pos] = next;
+                    pending[(long long)u * g.n + v].push_back(next++);
+                } else if (u > v) {
+                    auto& ids = pending[(long long)v * g.n + u];
+                    edgeId[pos] = ids.back();
+                    ids.pop_back();
+                } else if (openLoop < 0) {
+                    edgeId[pos] = openLoop = next++;
+                } else {
+                    edgeId[pos] = openLoop;
+                    openLoop = -1;
+                }
+            }
+        }
+    }
+
+    Graph toGraph() const {
+        Graph g(n);
+        for (int u = 0; u < n; ++u)
+            for (long long i = offset[u]; i < offset[u + 1]; ++i)
+                g.adj[u].push_back(target[(size_t)i]);
+        return g;
+    }
+
+    // Budowa z listy krawędzi sortowaniem przez zliczanie, O(n + m); numer krawędzi = indeks na liście
+    static CsrGraph fromEdges(int n, const vector<pair<int, int>>& edges) {
+        return fromEdgeList(n, (long long)edges.size(), [&](long long i) { return edges[(size_t)i]; });
+    }
+
+    // Wersja dla płaskiej tablicy par (u0, v0, u1, v1, ...), np. prosto z bufora wywołującego
+    static CsrGraph fromEdges(int n, const int* edges, long long m) {
+        return fromEdgeList(n, m, [=](long long i) { return make_pair(edges[2 * i], edges[2 * i + 1]); });
+    }
+
+    template <class Endpoints>
+    static CsrGraph fromEdgeList(int n, long long m, Endpoints edge) {
+        CsrGraph c;
+        c.n = n;
+        c.m = m;
+        c.offset.assign(n + 1, 0);
+        for (long long i = 0; i < m; ++i) {
+            pair<int, int> e = edge(i);
+            ++c.offset[e.first + 1];
+            ++c.offset[e.second + 1];
+        }
+        for (int v = 0; v < n; ++v) c.offset[v + 1] += c.offset[v];
+        c.target.resize((size_t)(2 * m));
+        c.edgeId.resize((size_t)(2 * m));
+        vector<long long> pos(c.offset.begin(), c.offset.end() - 1);
+        for (long long i = 0; i < m; ++i) {
+            pair<int, int> e = edge(i);
+            c.target[(size_t)pos[e.first]] = e.second;
+            c.edgeId[(size_t)pos[e.first]++] = (int)i;
+            c.target[(size_t)pos[e.second]] = e.first;
+            c.edgeId[(size_t)pos[e.second]++] = (int)i;
+        }
+        return c;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Równoległe prymitywy spójności na CSR
+// ---------------------------------------------------------------------------
+
+inline unsigned defaultThreads(unsigned threads) {
+    return threads ? threads : max(1u, thread::hardware_concurrency());
+}
+
+// Węzły NUMA, które mają procesory. Bez wsparcia systemu: jeden węzeł ze wszystkimi procesorami
+struct NumaTopology {
+    vector<int> id;            // numer węzła w systemie
+    vector<vector<int>> cpus;  // procesory logiczne węzła
+
+    int nodes() const { return (int)cpus.size(); }
+
+    int cpuCount() const {
+        int total = 0;
+        for (auto& c : cpus) total += (int)c.size();
+        return total;
+    }
+
+    // Węzeł "domowy" i-tego z threads wątków: wątki rozkładają się proporcjonalnie do procesorów
+    int homeNode(unsigned i, unsigned threads) const {
+        long long slot = (long long)i * cpuCount() / max(1u, threads), acc = 0;
+        for (int k = 0; k < nodes(); ++k)
+            if (slot < (acc += (long long)cpus[k].size())) return k;
+        return nodes() - 1;
+    }
+
+    static const NumaTopology& current() {
+        static const NumaTopology topology = detect();
+        return topology;
+    }
+
+    // Lista w formacie jądra Linuksa, np. "0-7,16-23"
+    static vector<int> parseList(const string& text) {
+        vector<int> list;
+        stringstream in(text);
+        string part;
+        while (getline(in, part, ',')) {
+            if (part.empty() || part[0] < '0' || part[0] > '9') continue;
+            size_t dash = part.find('-');
+            int lo = stoi(part), hi = dash == string::npos ? lo : stoi(part.substr(dash + 1));
+            for (int c = lo; c <= hi; ++c) list.push_back(c);
+        }
+        return list;
+    }
+
+    static NumaTopology detect() {
+        NumaTopology t;
+#ifdef _WIN32
+        ULONG highest = 0;
+        if (GetNumaHighestNodeNumber(&highest))
+            for (ULONG node = 0; node <= highest; ++node) {
+                GROUP_AFFINITY mask = {};
+                if (!GetNumaNodeProcessorMaskEx((USHORT)node, &mask) || !mask.Mask) continue;
+                vector<int> list;
+                for (int bit = 0; bit < (int)sizeof(mask.Mask) * 8; ++bit)
+                    if (mask.Mask >> bit & 1) list.push_back(mask.Group * 64 + bit);
+                t.id.push_back((int)node);
+                t.cpus.push_back(list);
+            }
+#elif defined(__linux__)
+        string online;
+        ifstream nodes("/sys/devices/system/node/online");
+        if (getline(nodes, online))
+            for (int node : parseList(online)) {
+                string line;
+                ifstream in("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+                vector<int> list = getline(in, line) ? parseList(line) : vector<int>();
+                if (list.empty()) continue;  // węzeł z samą pamięcią
+                t.id.push_back(node);
+                t.cpus.push_back(list);
+            }
+#endif
+        if (t.cpus.empty()) {
+            t.id.assign(1, 0);
+            t.cpus.assign(1, vector<int>());
+            for (unsigned c = 0; c < max(1u, thread::hardware_concurrency()); ++c) t.cpus[0].push_back((int)c);
+        }
+        return t;
+    }
+};
+
+// Przypina bieżący wątek do procesorów węzła; na maszynie z jednym węzłem nic nie robi
+inline bool pinThreadToNode(int node) {
+    const NumaTopology& t = NumaTopology::current();
+    if (t.nodes() < 2) return false;
+    node %= t.nodes();
+#ifdef _WIN32
+    GROUP_AFFINITY mask = {};
+    if (!GetNumaNodeProcessorMaskEx((USHORT)t.id[node], &mask)) return false;
+    return SetThreadGroupAffinity(GetCurrentThread(), &mask, nullptr) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : t.cpus[node]) CPU_SET(c, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// Podział [begin, end) na węzły proporcjonalnie do liczby ich procesorów: węzeł k dostaje
+// [bounds[k], bounds[k + 1]). Ten sam podział stosuje NumaCsrGraph przy rozmieszczaniu stron
+inline vector<long long> numaBounds(long long begin, long long end) {
+    const NumaTopology& t = NumaTopology::current();
+    vector<long long> bounds(1, begin);
+    long long acc = 0, total = t.cpuCount();
+    for (int k = 0; k < t.nodes(); ++k) {
+        acc += (long long)t.cpus[k].size();
+        bounds.push_back(begin + (end - begin) * acc / total);
+    }
+    return bounds;
+}
+
+// Liczniki pętli równoległych dla benchmarku skalowania: kawałki, kawałki wzięte z zakresu innego
+// węzła NUMA (tylko numaParallelFor), czas w body i czas dostępny (wątki x czas trwania pętli).
+// Bezczynność = 1 - praca / dostępny. Nierównowaga = suma po pętlach czasu pracy najbardziej
+// zajętego wątku / suma średnich czasów pracy wątku; 1 to równy podział
+struct ParallelStats {
+    atomic<long long> chunks{ 0 }, stolen{ 0 }, busyNs{ 0 }, availableNs{ 0 }, peakBusyNs{ 0 }, meanBusyNs{ 0 };
+
+    void reset() {
+        chunks = 0;
+        stolen = 0;
+        busyNs = 0;
+        availableNs = 0;
+        peakBusyNs = 0;
+        meanBusyNs = 0;
+    }
+};
+
+// Czas pracy wątków jednej pętli: suma i maksimum po wątkach
+struct LoopBusy {
+    atomic<long long> total{ 0 }, peak{ 0 };
+
+    void add(long long ns) {
+        total += ns;
+        long long p = peak.load();
+        while (ns > p && !peak.compare_exchange_weak(p, ns)) {}
+    }
+};
+
+// Aktywne liczniki; nullptr (domyślnie) = pętle bez pomiaru czasu
+inline atomic<ParallelStats*>& parallelStatsSink() {
+    static atomic<ParallelStats*> sink(nullptr);
+    return sink;
+}
+
+// Pomiar jednego wątku pętli, dopisywany do liczników przy zakończeniu wątku
+class ChunkMeter {
+public:
+    ChunkMeter(ParallelStats* s, LoopBusy& l) : stats(s), loop(l) {}
+    ~ChunkMeter() {
+        if (!stats) return;
+        stats->chunks += chunks;
+        stats->stolen += stolen;
+        stats->busyNs += busy;
+        loop.add(busy);
+    }
+
+    template <class F>
+    void run(F&& body, long long lo, long long hi, bool foreign) {
+        if (!stats) {
+            body(lo, hi);
+            return;
+        }
+        auto start = steady_clock::now();
+        body(lo, hi);
+        busy += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+        ++chunks;
+        stolen += foreign;
+    }
+
+private:
+    ParallelStats* stats;
+    LoopBusy& loop;
+    long long chunks = 0, stolen = 0, busy = 0;
+};
+
+inline void recordLoop(ParallelStats* stats, unsigned threads, steady_clock::time_point start, const LoopBusy& loop) {
+    if (!stats) return;
+    stats->availableNs += threads * duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    stats->peakBusyNs += loop.peak;
+    stats->meanBusyNs += loop.total / threads;
+}
+
+// Wątki przypięte do węzłów; wątek węzła k bierze kawałki najpierw ze swojego zakresu,
+// a po jego wyczerpaniu pomaga kolejnym węzłom. Wołający tylko czeka, więc jego
+// przypisanie do procesorów się nie zmienia
+template <class F>
+void numaParallelFor(const vector<long long>& bounds, unsigned threads, F body, long long grain = 4096) {
+    const NumaTopology& t = NumaTopology::current();
+    ParallelStats* stats = parallelStatsSink().load(memory_order_relaxed);
+    auto start = stats ? steady_clock::now() : steady_clock::time_point();
+    int parts = (int)bounds.size() - 1;
+    threads = max(defaultThreads(threads), (unsigned)t.nodes());
+    unique_ptr<atomic<long long>[]> next(new atomic<long long>[parts]);
+    for (int k = 0; k < parts; ++k) next[k].store(bounds[k]);
+    LoopBusy loop;
+    auto worker = [&](int home) {
+        pinThreadToNode(home);
+        ChunkMeter meter(stats, loop);
+        for (int step = 0; step < parts; ++step) {
+            int k = (home + step) % parts;
+            for (;;) {
+                long long lo = next[k].fetch_add(grain);
+                if (lo >= bounds[k + 1]) break;
+                meter.run(body, lo, min(bounds[k + 1], lo + grain), step > 0);
+            }
+        }
+    };
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back(worker, t.homeNode(i, threads));
+    for (auto& w : workers) w.join();
+    recordLoop(stats, threads, start, loop);
+}
+
+// Dzieli [begin, end) na kawałki po grain, pobierane dynamicznie przez wątki; body(lo, hi)
+template <class F>
+void parallelFor(long long begin, long long end, unsigned threads, F body, long long grain = 4096) {
+    threads = defaultThreads(threads);
+    ParallelStats* stats = parallelStatsSink().load(memory_order_relaxed);
+    auto start = stats ? steady_clock::now() : steady_clock::time_point();
+    LoopBusy loop;
+    if (end - begin <= grain || threads == 1) {
+        if (begin < end) ChunkMeter(stats, loop).run(body, begin, end, false);
+        recordLoop(stats, 1, start, loop);
+        return;
+    }
+    if (NumaTopology::current().nodes() > 1) {
+        numaParallelFor(numaBounds(begin, end), threads, body, grain);
+        return;
+    }
+    atomic<long long> next(begin);
+    auto worker = [&] {
+        ChunkMeter meter(stats, loop);
+        for (;;) {
+            long long lo = next.fetch_add(grain);
+            if (lo >= end) break;
+            meter.run(body, lo, min(end, lo + grain), false);
+        }
+    };
+    vector<thread> helpers;
+    for (unsigned t = 1; t < threads; ++t) helpers.emplace_back(worker);
+    worker();
+    for (auto& h : helpers) h.join();
+    recordLoop(stats, threads, start, loop);
+}
+
+// CSR rozłożony na węzły NUMA przez first-touch: zakres wierzchołków węzła k z numaBounds
+// razem z ich listami sąsiedztwa kopiują wątki przypięte do k, więc tam trafiają strony.
+// Tablice celowo nie są inicjalizowane przy alokacji (new T[] dla typów prostych)
+class NumaCsrGraph {
+public:
+    int n = 0;
+    long long m = 0;
+    unique_ptr<long long[]> offset;
+    unique_ptr<int[]> target, edgeId;
+    vector<long long> bounds;  // zakresy wierzchołków kolejnych węzłów
+
+    CsrView view() const { return { n, m, offset.get(), target.get(), edgeId.get() }; }
+
+    static NumaCsrGraph place(const CsrView& g, unsigned threads = 0) {
+        NumaCsrGraph c;
+        c.n = g.n;
+        c.m = g.m;
+        c.offset.reset(new long long[(size_t)g.n + 1]);
+        c.target.reset(new int[(size_t)g.offset[g.n] + 1]);
+        c.edgeId.reset(new int[(size_t)g.offset[g.n] + 1]);
+        c.bounds = numaBounds(0, g.n);
+        c.offset[g.n] = g.offset[g.n];
+        numaParallelFor(c.bounds, threads, [&](long long lo, long long hi) {
+            copy(g.offset + lo, g.offset + hi, c.offset.get() + lo);
+            copy(g.target + g.offset[lo], g.target + g.offset[hi], c.target.get() + g.offset[lo]);
+            copy(g.edgeId + g.offset[lo], g.edgeId + g.offset[hi], c.edgeId.get() + g.offset[lo]);
+        });
+        return c;
+    }
+
+    // Węzeł, na którym leży wierzchołek v
+    int nodeOf(int v) const {
+        return (int)(upper_bound(bounds.begin(), bounds.end(), (long long)v) - bounds.begin()) - 1;
+    }
+};
+
+// Losowy rzadki multigraf o zadanym średnim stopniu, budowany od razu jako CSR
+inline CsrGraph randomSparseCsr(int n, double avgDegree, unsigned seed) {
+    mt19937_64 gen(seed);
+    uniform_int_distribution<int> vertex(0, n - 1);
+    vector<pair<int, int>> edges((size_t)(avgDegree * n / 2));
+    for (auto& e : edges) {
+        e.first = vertex(gen);
+        do e.second = vertex(gen); while (n > 1 && e.second == e.first);
+    }
+    return CsrGraph::fromEdges(n, edges);
+}
+
+// Suma "cycles" losowych cykli Hamiltona: każdy wierzchołek ma stopień 2 * cycles,
+// graf jest spójny, więc zawsze eulerowski (krawędzie wielokrotne są dozwolone)
+inline CsrGraph randomEulerianCsr(int n, int cycles, unsigned seed) {
+    mt19937_64 gen(seed);
+    vector<int> order(n);
+    vector<pair<int, int>> edges;
+    edges.reserve((size_t)n * cycles);
+    for (int c = 0; c < cycles && n > 2; ++c) {
+        for (int v = 0; v < n; ++v) order[v] = v;
+        shuffle(order.begin(), order.end(), gen);
+        for (int i = 0; i < n; ++i) edges.push_back({ order[i], order[(i + 1) % n] });
+    }
+    return CsrGraph::fromEdges(n, edges);
+}
+
+// ---------------------------------------------------------------------------
+// Generatory przestrzenne: sieci zbliżone do drogowych
+// ---------------------------------------------------------------------------
+
+// Graf z położeniami wierzchołków w kwadracie jednostkowym; weight[e] to długość euklidesowa
+// krawędzi o numerze e (edgeId), pusty wektor dla grafu bez wag
+struct SpatialGraph {
+    CsrGraph graph;
+    vector<double> x, y;
+    vector<double> weight;
+};
+
+// Liczba pseudolosowa zależna tylko od (seed, i) (SplitMix64), więc punkty i krawędzie
+// nie zależą od podziału pracy między wątki
+inline uint64_t mixSeed(uint64_t seed, uint64_t i) {
+    uint64_t z = seed * 0x9E3779B97F4A7C15ULL + i + 0x632BE59BD9B4E019ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline double unitFromBits(uint64_t bits) { return (bits >> 11) * (1.0 / 9007199254740992.0); }
+
+// Krawędzie zbierane równolegle: emit(i, out) dopisuje krawędzie elementu i z [0, count).
+// Każdy blok elementów ma własny bufor, a bufory są sklejane w kolejności bloków - wynik
+// jest ten sam dla każdej liczby wątków
+template <class F>
+vector<pair<int, int>> parallelEdges(long long count, unsigned threads, F emit, long long block = 1024) {
+    vector<vector<pair<int, int>>> parts((size_t)((count + block - 1) / block));
+    parallelFor(0, (long long)parts.size(), threads, [&](long long lo, long long hi) {
+        for (long long p = lo; p < hi; ++p)
+            for (long long i = p * block; i < min(count, (p + 1) * block); ++i) emit(i, parts[(size_t)p]);
+    }, 1);
+    size_t total = 0;
+    for (auto& part : parts) total += part.size();
+    vector<pair<int, int>> edges;
+    edges.reserve(total);
+    for (auto& part : parts) edges.insert(edges.end(), part.begin(), part.end());
+    return edges;
+}
+
+inline void spatialWeights(SpatialGraph& s, unsigned threads) {
+    const CsrView g = s.graph.view();
+    s.weight.assign((size_t)g.m, 0);
+    parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+        for (long long v = lo; v < hi; ++v)
+            for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+                if (g.target[i] > v)
+                    s.weight[g.edgeId[i]] = hypot(s.x[v] - s.x[g.target[i]], s.y[v] - s.y[g.target[i]]);
+    });
+}
+
+// Losowy graf geometryczny: n punktów jednostajnie w kwadracie, krawędź przy odległości <= r,
+// r dobrane do średniego stopnia (n pi r^2 = avgDegree). Sąsiadów szukamy w siatce komórek o boku
+// >= r, więc tylko w 3 x 3 komórkach - O(n) zamiast O(n^2). Wierzchołki ponumerowane w kolejności
+// komórek, więc sąsiedzi w grafie są zwykle blisko także w pamięci
+inline SpatialGraph randomGeometricGraph(int n, double avgDegree, unsigned seed, bool weighted = false,
+                                         unsigned threads = 0) {
+    SpatialGraph s;
+    double r = sqrt(avgDegree / (acos(-1.0) * max(n, 1)));
+    int side = max(1, min((int)(1 / r), (int)sqrt((double)n) + 1));
+    long long cells = (long long)side * side;
+    vector<double> px(n), py(n);
+    vector<int> cellOf(n);
+    parallelFor(0, n, threads, [&](long long lo, long long hi) {
+        for (long long i = lo; i < hi; ++i) {
+            px[i] = unitFromBits(mixSeed(seed, 2 * i));
+            py[i] = unitFromBits(mixSeed(seed, 2 * i + 1));
+            cellOf[i] = min(side - 1, (int)(py[i] * side)) * side + min(side - 1, (int)(px[i] * side));
+        }
+    });
+    // Sortowanie kubełkowe punktów po komórkach
+    vector<int> start((size_t)cells + 1, 0);
+    for (int i = 0; i < n; ++i) ++start[cellOf[i] + 1];
+    for (long long c = 0; c < cells; ++c) start[c + 1] += start[c];
+    vector<int> slot(start.begin(), start.end() - 1);
+    s.x.resize(n);
+    s.y.resize(n);
+    for (int i = 0; i < n; ++i) {
+        int v = slot[cellOf[i]]++;
+        s.x[v] = px[i];
+        s.y[v] = py[i];
+    }
+
+    // Każda para raz: ta sama komórka (u > v) i cztery komórki "do przodu"
+    const int forward[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+    double r2 = r * r;
+    vector<pair<int, int>> edges = parallelEdges(cells, threads, [&](long long c, vector<pair<int, int>>& out) {
+        int cx = (int)(c % side), cy = (int)(c / side);
+        for (int v = start[c]; v < start[c + 1]; ++v) {
+            for (int u = v + 1; u < start[c + 1]; ++u)
+                if ((s.x[u] - s.x[v]) * (s.x[u] - s.x[v]) + (s.y[u] - s.y[v]) * (s.y[u] - s.y[v]) <= r2)
+                    out.push_back({ v, u });
+            for (auto& f : forward) {
+                int nx = cx + f[0], ny = cy + f[1];
+                if (nx < 0 || nx >= side || ny >= side) continue;
+                long long d = (long long)ny * side + nx;
+                for (int u = start[d]; u < start[d + 1]; ++u)
+                    if ((s.x[u] - s.x[v]) * (s.x[u] - s.x[v]) + (s.y[u] - s.y[v]) * (s.y[u] - s.y[v]) <= r2)
+                        out.push_back({ v, u });
+            }
+        }
+    }, 64);
+    s.graph = CsrGraph::fromEdges(n, edges);
+    if (weighted) spatialWeights(s, threads);
+    return s;
+}
+
+// Siatka rows x cols (rows * cols >= n, wiersze pełne) z punktami przesuniętymi losowo
+// o najwyżej jitter boku komórki w każdej osi. Wierzchołek (i, j) ma numer i * cols + j
+inline SpatialGraph jitteredLattice(int n, double jitter, unsigned seed, int& rows, int& cols, unsigned threads) {
+    SpatialGraph s;
+    cols = max(1, (int)ceil(sqrt((double)n)));
+    rows = max(1, (n + cols - 1) / cols);
+    long long points = (long long)rows * cols;
+    s.x.resize((size_t)points);
+    s.y.resize((size_t)points);
+    parallelFor(0, points, threads, [&](long long lo, long long hi) {
+        for (long long v = lo; v < hi; ++v) {
+            double dx = (2 * unitFromBits(mixSeed(seed, 2 * v)) - 1) * jitter;
+            double dy = (2 * unitFromBits(mixSeed(seed, 2 * v + 1)) - 1) * jitter;
+            s.x[v] = (v % cols + 0.5 + dx) / cols;
+            s.y[v] = (v / cols + 0.5 + dy) / rows;
+        }
+    });
+    return s;
+}
+
+// Triangulacja planarna podobna do Delaunaya: siatka z przesunięciem < 1/4 komórki (czworokąty
+// komórek pozostają wypukłe), w każdym czworokącie przekątna wybrana testem pustego okręgu.
+// Wynik jest lokalnie delaunayowski (żadnej przekątnej nie trzeba odwracać), stopnie ~6.
+// Prawdziwy Delaunay dla punktów jednostajnych kosztuje O(n log n) i jest sekwencyjny - tu O(n)
+inline SpatialGraph delaunayLikeTriangulation(int n, unsigned seed, bool weighted = false, unsigned threads = 0) {
+    int rows, cols;
+    SpatialGraph s = jitteredLattice(n, 0.2, seed, rows, cols, threads);
+    // > 0, gdy d leży wewnątrz okręgu opisanego na a, b, c (dowolna orientacja a, b, c)
+    auto inCircle = [&](int a, int b, int c, int d) {
+        double ax = s.x[a] - s.x[d], ay = s.y[a] - s.y[d], bx = s.x[b] - s.x[d], by = s.y[b] - s.y[d];
+        double cx = s.x[c] - s.x[d], cy = s.y[c] - s.y[d];
+        double det = (ax * ax + ay * ay) * (bx * cy - cx * by) - (bx * bx + by * by) * (ax * cy - cx * ay) +
+                     (cx * cx + cy * cy) * (ax * by - bx * ay);
+        double orient = (s.x[b] - s.x[a]) * (s.y[c] - s.y[a]) - (s.y[b] - s.y[a]) * (s.x[c] - s.x[a]);
+        return det * orient > 0;
+    };
+    vector<pair<int, int>> edges = parallelEdges(rows, threads, [&](long long i, vector<pair<int, int>>& out) {
+        for (int j = 0; j < cols; ++j) {
+            int a = (int)i * cols + j, b = a + 1, d = a + cols, c = d + 1;
+            if (j + 1 < cols) out.push_back({ a, b });
+            if (i + 1 < rows) out.push_back({ a, d });
+            if (j + 1 < cols && i + 1 < rows) {
+                if (inCircle(a, b, c, d)) out.push_back({ b, d });
+                else out.push_back({ a, c });
+            }
+        }
+    }, 16);
+    s.graph = CsrGraph::fromEdges(rows * cols, edges);
+    if (weighted) spatialWeights(s, threads);
+    return s;
+}
+
+// Siatka ulic: przesunięte punkty siatki, krawędzie do sąsiadów w poziomie i pionie, każda
+// usunięta z prawdopodobieństwem drop (ślepe uliczki, brakujące przejazdy)
+inline SpatialGraph perturbedGrid(int n, double jitter, double drop, unsigned seed, bool weighted = false,
+                                  unsigned threads = 0) {
+    int rows, cols;
+    SpatialGraph s = jitteredLattice(n, jitter, seed, rows, cols, threads);
+    uint64_t edgeSeed = mixSeed(seed, ~0ULL);
+    vector<pair<int, int>> edges = parallelEdges(rows, threads, [&](long long i, vector<pair<int, int>>& out) {
+        for (int j = 0; j < cols; ++j) {
+            long long a = i * cols + j;
+            if (j + 1 < cols && unitFromBits(mixSeed(edgeSeed, 2 * a)) >= drop) out.push_back({ (int)a, (int)a + 1 });
+            if (i + 1 < rows && unitFromBits(mixSeed(edgeSeed, 2 * a + 1)) >= drop)
+                out.push_back({ (int)a, (int)(a + cols) });
+        }
+    }, 16);
+    s.graph = CsrGraph::fromEdges(rows * cols, edges);
+    if (weighted) spatialWeights(s, threads);
+    return s;
+}
+
+// Afforest: najpierw łączy po dwóch sąsiadów każdego wierzchołka, potem pomija największą
+// (wylosowaną) składową i dopiero resztę krawędzi przegląda w całości. Wynik: etykieta składowej
+inline vector<int> connectedComponents(const CsrView& g, unsigned threads = 0) {
+    // Bez inicjalizacji przy alokacji: strony rozkłada pierwszy zapis wątków przypiętych do węzłów
+    unique_ptr<atomic<int>[]> comp(new atomic<int>[(size_t)g.n]);
+    parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+        for (long long v = lo; v < hi; ++v) comp[v].store((int)v, memory_order_relaxed);
+    });
+
+    // Podpinanie korzenia o większym numerze pod mniejszy (CAS, bez blokad)
+    auto link = [&](int u, int v) {
+        int p1 = comp[u].load(memory_order_relaxed), p2 = comp[v].load(memory_order_relaxed);
+        while (p1 != p2) {
+            int high = max(p1, p2), low = min(p1, p2);
+            int pHigh = comp[high].load(memory_order_relaxed);
+            if (pHigh == low) break;
+            if (pHigh == high && comp[high].compare_exchange_strong(pHigh, low)) break;
+            p1 = comp[comp[high].load(memory_order_relaxed)].load(memory_order_relaxed);
+            p2 = comp[low].load(memory_order_relaxed);
+        }
+    };
+    auto compress = [&] {
+        parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+            for (long long v = lo; v < hi; ++v) {
+                int c = comp[v].load(memory_order_relaxed);
+                while (c != comp[c].load(memory_order_relaxed)) c = comp[c].load(memory_order_relaxed);
+                comp[v].store(c, memory_order_relaxed);
+            }
+        });
+    };
+
+    const int rounds = 2;
+    for (int r = 0; r < rounds; ++r) {
+        parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+            for (long long v = lo; v < hi; ++v)
+                if (g.offset[v] + r < g.offset[v + 1]) link((int)v, g.target[g.offset[v] + r]);
+        });
+        compress();
+    }
+
+    int largest = -1;
+    if (g.n > 0) {
+        mt19937 gen(12345);
+        uniform_int_distribution<int> pick(0, g.n - 1);
+        unordered_map<int, int> count;
+        int best = 0;
+        for (int s = 0; s < 1024; ++s) {
+            int c = comp[pick(gen)].load(memory_order_relaxed);
+            if (++count[c] > best) { best = count[c]; largest = c; }
+        }
+    }
+
+    parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+        for (long long v = lo; v < hi; ++v) {
+            if (comp[v].load(memory_order_relaxed) == largest) continue;
+            for (long long i = g.offset[v] + rounds; i < g.offset[v + 1]; ++i) link((int)v, g.target[i]);
+        }
+    }, 1024);
+    compress();
+
+    vector<int> labels(g.n);
+    for (int v = 0; v < g.n; ++v) labels[v] = comp[v].load(memory_order_relaxed);
+    return labels;
+}
+
+inline int componentCount(const vector<int>& labels) {
+    int count = 0;
+    for (int v = 0; v < (int)labels.size(); ++v) count += labels[v] == v;
+    return count;
+}
+
+struct BfsResult {
+    vector<int> parent;  // -1 dla nieosiągniętych, źródło jest swoim rodzicem
+    vector<int> depth;
+    int levels = 0;
+    int bottomUpLevels = 0;
+};
+
+// BFS z optymalizacją kierunku (Beamer): krok top-down dla małych frontów, bottom-up, gdy front
+// ma więcej krawędzi niż nieodwiedzona część grafu / alpha, i powrót, gdy front spadnie poniżej n / beta
+inline BfsResult directionOptimizingBfs(const CsrView& g, int source, unsigned threads = 0,
+                                        double alpha = 15.0, double beta = 18.0) {
+    BfsResult result;
+    vector<atomic<int>> parent(g.n);
+    result.depth.assign(g.n, -1);
+    parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+        for (long long v = lo; v < hi; ++v) parent[v].store(-1, memory_order_relaxed);
+    });
+    parent[source].store(source);
+    result.depth[source] = 0;
+
+    vector<int> frontier = { source };
+    vector<char> inFrontier, inNext;
+    bool bottomUp = false;
+    long long frontierSize = 1;
+    long long frontierEdges = g.degree(source);
+    long long unexploredEdges = 2 * g.m - frontierEdges;
+    mutex merge;
+
+    for (int level = 1; frontierSize > 0; ++level) {
+        bool wantBottomUp = bottomUp ? frontierSize >= g.n / beta : frontierEdges > unexploredEdges / alpha;
+        if (wantBottomUp != bottomUp) {
+            if (wantBottomUp) {
+                inFrontier.assign(g.n, 0);
+                for (int v : frontier) inFrontier[v] = 1;
+            } else {
+                frontier.clear();
+                for (int v = 0; v < g.n; ++v)
+                    if (inFrontier[v]) frontier.push_back(v);
+            }
+            bottomUp = wantBottomUp;
+        }
+
+        atomic<long long> nextSize(0), nextEdges(0);
+        if (bottomUp) {
+            ++result.bottomUpLevels;
+            inNext.assign(g.n, 0);
+            parallelFor(0, g.n, threads, [&](long long lo, long long hi) {
+                long long found = 0, edges = 0;
+                for (long long v = lo; v < hi; ++v) {
+                    if (parent[v].load(memory_order_relaxed) >= 0) continue;
+                    for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+                        int u = g.target[i];
+                        if (!inFrontier[u]) continue;
+                        parent[v].store(u, memory_order_relaxed);
+                        result.depth[v] = level;
+                        inNext[v] = 1;
+                        ++found;
+                        edges += g.degree((int)v);
+                        break;
+                    }
+                }
+                nextSize += found;
+                nextEdges += edges;
+            });
+            inFrontier.swap(inNext);
+        } else {
+            vector<int> next;
+            parallelFor(0, (long long)frontier.size(), threads, [&](long long lo, long long hi) {
+                vector<int> local;
+                long long edges = 0;
+                for (long long k = lo; k < hi; ++k) {
+                    int u = frontier[k];
+                    for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+                        int v = g.target[i];
+                        int none = -1;
+                        if (parent[v].load(memory_order_relaxed) < 0 && parent[v].compare_exchange_strong(none, u)) {
+                            result.depth[v] = level;
+                            local.push_back(v);
+                            edges += g.degree(v);
+                        }
+                    }
+                }
+                nextEdges += edges;
+                lock_guard<mutex> lk(merge);
+                next.insert(next.end(), local.begin(), local.end());
+            }, 256);
+            nextSize = (long long)next.size();
+            frontier.swap(next);
+        }
+
+        frontierSize = nextSize;
+        frontierEdges = nextEdges;
+        unexploredEdges -= frontierEdges;
+        if (frontierSize > 0) result.levels = level;
+    }
+
+    result.parent.resize(g.n);
+    for (int v = 0; v < g.n; ++v) result.parent[v] = parent[v].load(memory_order_relaxed);
+    return result;
+}
+
+// Cykl Eulera istnieje: parzyste stopnie i wszystkie krawędzie w jednej składowej
+inline bool csrIsEulerian(const CsrView& g, unsigned threads = 0) {
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) % 2 != 0) return false;
+    vector<int> labels = connectedComponents(g, threads);
+    int component = -1;
+    for (int v = 0; v < g.n; ++v) {
+        if (g.degree(v) == 0) continue;
+        if (component < 0) component = labels[v];
+        else if (labels[v] != component) return false;
+    }
+    return true;
+}
+
+// Szybkie odrzucenie przed przeszukiwaniem: cykl Hamiltona (n >= 3) wymaga stopni >= 2 i spójności
+inline bool hamiltonPrescreen(const CsrView& g, unsigned threads = 1) {
+    if (g.n < 3) return true;
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) < 2) return false;
+    return componentCount(connectedComponents(g, threads)) == 1;
+}
+
+// Numer najniższego ustawionego bitu (x != 0)
+inline int lowestBit(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Sąsiedztwo dobierane osobno dla każdego wierzchołka: huby (stopień >= hubDegree) dostają
+// wiersz bitowy z testem krawędzi w O(1), pozostałe posortowaną tablicę sąsiadów.
+// Pamięć: n/8 bajtów na hub i 4 bajty na krawędź reszty zamiast n²/8 dla całej macierzy
+class HybridAdjacency {
+public:
+    explicit HybridAdjacency(const CsrView& g, int hubDegree = 0) : n(g.n) {
+        if (hubDegree <= 0) hubDegree = max(64, n / 32);
+        words = (n + 63) / 64;
+        rowOf.assign(n, -1);
+        degrees.assign(n, 0);
+        offset.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            if (g.degree(v) >= hubDegree) rowOf[v] = hubs++;
+            else offset[v + 1] = g.degree(v);
+        }
+        for (int v = 0; v < n; ++v) offset[v + 1] += offset[v];
+        sorted.resize((size_t)offset[n]);
+        rows.assign((size_t)hubs * words, 0);
+        for (int v = 0; v < n; ++v) {
+            const int* first = g.target + g.offset[v];
+            const int* last = g.target + g.offset[v + 1];
+            if (rowOf[v] >= 0) {
+                uint64_t* row = &rows[(size_t)rowOf[v] * words];
+                for (const int* u = first; u != last; ++u) row[*u >> 6] |= 1ull << (*u & 63);
+                for (int w = 0; w < words; ++w) degrees[v] += popcount(row[w]);
+            } else {
+                int* out = sorted.data() + offset[v];
+                copy(first, last, out);
+                sort(out, out + (last - first));
+                degrees[v] = (int)(unique(out, out + (last - first)) - out);
+            }
+        }
+    }
+
+    bool isHub(int v) const { return rowOf[v] >= 0; }
+    int degree(int v) const { return degrees[v]; }  // bez krawędzi równoległych
+
+    bool hasEdge(int u, int v) const {
+        if (rowOf[u] >= 0) return bit(u, v);
+        if (rowOf[v] >= 0) return bit(v, u);
+        if (degrees[u] > degrees[v]) swap(u, v);
+        const int* first = sorted.data() + offset[u];
+        return binary_search(first, first + degrees[u], v);
+    }
+
+    // f(u) dla każdego sąsiada v w kolejności rosnącej
+    template <class F>
+    void forEachNeighbor(int v, F f) const {
+        if (rowOf[v] < 0) {
+            const int* first = sorted.data() + offset[v];
+            for (int i = 0; i < degrees[v]; ++i) f(first[i]);
+            return;
+        }
+        const uint64_t* row = &rows[(size_t)rowOf[v] * words];
+        for (int w = 0; w < words; ++w)
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) f(w * 64 + lowestBit(bits));
+    }
+
+    int hubCount() const { return hubs; }
+
+    size_t memoryBytes() const {
+        return rows.size() * sizeof(uint64_t) + sorted.size() * sizeof(int) + offset.size() * sizeof(long long) +
+               (rowOf.size() + degrees.size()) * sizeof(int);
+    }
+
+private:
+    bool bit(int hub, int v) const { return (rows[(size_t)rowOf[hub] * words + (v >> 6)] >> (v & 63)) & 1; }
+
+    static int popcount(uint64_t x) {
+        int c = 0;
+        for (; x; x &= x - 1) ++c;
+        return c;
+    }
+
+    int n, words = 0, hubs = 0;
+    vector<int> rowOf, degrees, sorted;
+    vector<long long> offset;
+    vector<uint64_t> rows;
+};
+
+// Wynik przeszukiwania, które można przerwać
+enum class SolveStatus { Found, NotFound, Aborted };
+
+// Postęp przeszukiwania czytany przez wątek raportujący. Solver liczy w zwykłych polach
+// SearchControl i co 1024 węzły publikuje migawkę przez zmienne atomowe (relaxed), więc koszt
+// na węzeł to kilka inkrementacji; profil głębokości jest próbkowany z tą samą częstotliwością
+struct SearchProgress {
+    static const int trackedLevels = 16;
+
+    atomic<long long> nodes{ 0 }, pruned{ 0 }, backtracks{ 0 };
+    atomic<int> depth{ 0 }, maxDepth{ 0 };
+    // Dla pierwszych poziomów: który z ilu sąsiadów jest teraz badany (oszacowanie postępu)
+    atomic<int> branch[trackedLevels], branches[trackedLevels];
+    vector<atomic<long long>> depthSamples;
+    steady_clock::time_point started = steady_clock::now();
+
+    explicit SearchProgress(int n) : depthSamples(n + 2) {
+        for (int d = 0; d < trackedLevels; ++d) { branch[d] = 0; branches[d] = 0; }
+        for (auto& c : depthSamples) c = 0;
+    }
+
+    // Część drzewa za nami: suma (indeks / liczba gałęzi) ważona iloczynem 1 / liczba gałęzi przodków
+    double exploredFraction() const {
+        double fraction = 0, weight = 1;
+        for (int d = 1; d < trackedLevels; ++d) {
+            int count = branches[d].load(memory_order_relaxed);
+            if (count <= 0) break;
+            fraction += weight * branch[d].load(memory_order_relaxed) / count;
+            weight /= count;
+        }
+        return fraction;
+    }
+};
+
+// Przerwanie długiego przeszukiwania: flaga anulowania i termin sprawdzane co pewną liczbę węzłów
+struct SearchControl {
+    atomic<bool> cancelled{ false };
+    steady_clock::time_point deadline = steady_clock::time_point::max();
+    long long nodes = 0, pruned = 0, backtracks = 0;
+    int maxDepth = 0;
+    bool stopped = false;
+    SearchProgress* progress = nullptr;
+    SearchControl* parent = nullptr;  // anulowanie rodzica przerywa też podzadania
+
+    bool shouldStop() {
+        if (stopped) return true;
+        if ((++nodes & 1023) != 0) return false;
+        stopped = expired();
+        return stopped;
+    }
+
+    // Sprawdzenie bez licznika i bez zapisu: dla pętli, w których jeden krok trwa długo,
+    // także z wielu wątków naraz
+    bool expired() const {
+        if (cancelled.load(memory_order_relaxed) ||
+            (deadline != steady_clock::time_point::max() && steady_clock::now() >= deadline))
+            return true;
+        for (const SearchControl* p = parent; p; p = p->parent)
+            if (p->cancelled.load(memory_order_relaxed)) return true;
+        return false;
+    }
+
+    // Migawka dla SearchProgress; path to bieżąca ścieżka od korzenia przeszukiwania
+    void publish(const CsrView& g, const vector<int>& path) {
+        int depth = (int)path.size();
+        progress->nodes.store(nodes, memory_order_relaxed);
+        progress->pruned.store(pruned, memory_order_relaxed);
+        progress->backtracks.store(backtracks, memory_order_relaxed);
+        progress->depth.store(depth, memory_order_relaxed);
+        progress->maxDepth.store(maxDepth, memory_order_relaxed);
+        auto& samples = progress->depthSamples[min(depth, (int)progress->depthSamples.size() - 1)];
+        samples.store(samples.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        for (int d = 1; d < SearchProgress::trackedLevels; ++d) {
+            int count = d < depth ? g.degree(path[d - 1]) : 0;
+            int index = 0;
+            if (count) {
+                const int* first = g.target + g.offset[path[d - 1]];
+                index = (int)(find(first, first + count, path[d]) - first);
+            }
+            progress->branch[d].store(index, memory_order_relaxed);
+            progress->branches[d].store(count, memory_order_relaxed);
+        }
+    }
+};
+
+// Iteracyjny Hierholzer na CSR: zwraca ten sam cykl co Graph::euler, ale bez rekurencji
+// i bez macierzy n², stan to jeden bajt na krawędź i wskaźnik na wierzchołek.
+// Cykl trafia do out (co najmniej m + 1 miejsc), wynikiem jest jego długość
+inline long long csrEulerInto(const CsrView& g, int start, int* out) {
+    vector<char> usedEdge((size_t)g.m, 0);
+    vector<long long> next(g.offset, g.offset + g.n);
+    vector<int> stack = { start };
+    long long length = 0;
+    while (!stack.empty()) {
+        int v = stack.back();
+        long long& i = next[v];
+        while (i < g.offset[v + 1] && usedEdge[(size_t)g.edgeId[i]]) ++i;
+        if (i == g.offset[v + 1]) {
+            out[length++] = v;
+            stack.pop_back();
+        } else {
+            usedEdge[(size_t)g.edgeId[i]] = 1;
+            stack.push_back(g.target[i]);
+        }
+    }
+    return length;
+}
+
+inline vector<int> csrEuler(const CsrView& g, int start) {
+    vector<int> cycle((size_t)g.m + 1);
+    cycle.resize((size_t)csrEulerInto(g, start, cycle.data()));
+    return cycle;
+}
+
+inline void prefetch(const void* p) {
+#ifdef _MSC_VER
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#else
+    __builtin_prefetch(p);
+#endif
+}
+
+struct EulerTask {
+    CsrView g;
+    int start;
+};
+
+// AMAC: "width" przejść Hierholzera naraz na jednym rdzeniu. Każdy krok jednego przejścia
+// to jedno dostępne w pamięci podręcznej odczytanie + prefetch tego, czego potrzebuje jego
+// następny krok; zanim do niego wróci, obsłuży pozostałe, więc chybienia się nakładają.
+// Ręczna maszyna stanów zamiast korutyn (C++14). Wyniki identyczne z csrEuler
+inline vector<vector<int>> interleavedEuler(const vector<EulerTask>& tasks, int width = 8) {
+    enum Stage { Top, Scan, Check, Take };
+    struct Walk {
+        int task = -1;
+        Stage stage = Top;
+        int v = 0;
+        long long i = 0;
+        vector<char> usedEdge;
+        vector<long long> next;
+        vector<int> stack;
+        vector<int> cycle;
+    };
+    vector<vector<int>> result(tasks.size());
+    vector<Walk> ring((size_t)max(1, min(width, (int)tasks.size())));
+    size_t pending = 0;
+    int active = 0;
+    auto launch = [&](Walk& w) {
+        w.task = -1;
+        if (pending == tasks.size()) return;
+        const CsrView& g = tasks[pending].g;
+        w.task = (int)pending++;
+        w.stage = Top;
+        w.usedEdge.assign((size_t)g.m, 0);
+        w.next.assign(g.offset, g.offset + g.n);
+        w.stack.assign(1, tasks[w.task].start);
+        w.cycle.clear();
+        w.cycle.reserve((size_t)g.m + 1);
+        ++active;
+    };
+    for (auto& w : ring) launch(w);
+
+    while (active > 0) {
+        for (auto& w : ring) {
+            if (w.task < 0) continue;
+            const CsrView& g = tasks[w.task].g;
+            switch (w.stage) {
+            case Top:
+                w.v = w.stack.back();
+                prefetch(&w.next[w.v]);
+                prefetch(&g.offset[w.v + 1]);
+                w.stage = Scan;
+                break;
+            case Scan:
+                w.i = w.next[w.v];
+                if (w.i == g.offset[w.v + 1]) {
+                    w.cycle.push_back(w.v);
+                    w.stack.pop_back();
+                    if (w.stack.empty()) {
+                        result[w.task] = move(w.cycle);
+                        --active;
+                        launch(w);
+                    } else {
+                        w.stage = Top;
+                    }
+                    break;
+                }
+                prefetch(&g.edgeId[w.i]);
+                prefetch(&g.target[w.i]);
+                w.stage = Check;
+                break;
+            case Check:
+                prefetch(&w.usedEdge[(size_t)g.edgeId[w.i]]);
+                w.stage = Take;
+                break;
+            case Take:
+                if (w.usedEdge[(size_t)g.edgeId[w.i]]) {
+                    ++w.next[w.v];
+                    w.stage = Scan;
+                    break;
+                }
+                w.usedEdge[(size_t)g.edgeId[w.i]] = 1;
+                w.v = g.target[w.i];
+                w.stack.push_back(w.v);
+                prefetch(&w.next[w.v]);
+                prefetch(&g.offset[w.v + 1]);
+                w.stage = Scan;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Euler na grafie podzielonym między procesy
+// ---------------------------------------------------------------------------
+
+// Hierholzer na liście krawędzi: osobny obwód dla każdej składowej z krawędziami. Obwód to ciąg
+// (numer krawędzi, czy przechodzona od second do first)
+inline vector<vector<pair<int, bool>>> eulerCircuits(int n, const vector<pair<int, int>>& edges) {
+    CsrGraph c = CsrGraph::fromEdges(n, edges);
+    vector<char> used(edges.size(), 0);
+    vector<long long> next(c.offset.begin(), c.offset.end() - 1);
+    vector<vector<pair<int, bool>>> circuits;
+    vector<pair<int, long long>> stack;  // wierzchołek i półkrawędź, którą do niego weszliśmy
+    for (int s = 0; s < n; ++s) {
+        while (next[s] < c.offset[s + 1] && used[c.edgeId[next[s]]]) ++next[s];
+        if (next[s] == c.offset[s + 1]) continue;
+        vector<pair<int, bool>> circuit;
+        stack.push_back({ s, -1 });
+        while (!stack.empty()) {
+            int v = stack.back().first;
+            long long& i = next[v];
+            while (i < c.offset[v + 1] && used[c.edgeId[i]]) ++i;
+            if (i < c.offset[v + 1]) {
+                used[c.edgeId[i]] = 1;
+                stack.push_back({ c.target[i], i });
+                continue;
+            }
+            long long in = stack.back().second;
+            stack.pop_back();
+            if (in >= 0) {
+                int e = c.edgeId[in], from = stack.back().first;
+                circuit.push_back({ e, edges[e].first != from });
+            }
+        }
+        reverse(circuit.begin(), circuit.end());
+        circuits.push_back(move(circuit));
+    }
+    return circuits;
+}
+
+// Wierzchołki 0..k-1 z odd(v) łączy kolejno w pary krawędziami pozornymi, dopisanymi do edges
+// za prawdziwymi; w obwodzie Eulera po takim uzupełnieniu ślady zaczynają się i kończą na nich
+template <class Odd>
+void addVirtualEdges(vector<pair<int, int>>& edges, int k, Odd odd) {
+    int unpaired = -1;
+    for (int v = 0; v < k; ++v)
+        if (odd(v)) {
+            if (unpaired < 0) unpaired = v;
+            else { edges.push_back({ unpaired, v }); unpaired = -1; }
+        }
+}
+
+// Tnie obwód na krawędziach pozornych (numery od real) i każdy ślad - ciąg wierzchołków
+// z numeracji edges - przekazuje do emit(ślad). Obwód zaczyna się tuż za pierwszą krawędzią
+// pozorną, jeśli ją ma, więc żaden ślad nie jest rozcięty na końcu obwodu
+template <class Emit>
+void splitAtVirtualEdges(const vector<pair<int, bool>>& circuit, const vector<pair<int, int>>& edges, size_t real,
+                         Emit emit) {
+    size_t first = 0;
+    for (size_t j = 0; j < circuit.size(); ++j)
+        if ((size_t)circuit[j].first >= real) { first = j + 1; break; }
+    vector<int> trail;
+    for (size_t t = 0; t < circuit.size(); ++t) {
+        auto step = circuit[(first + t) % circuit.size()];
+        if ((size_t)step.first >= real) {
+            if (!trail.empty()) emit(trail);
+            trail.clear();
+            continue;
+        }
+        const pair<int, int>& e = edges[step.first];
+        if (trail.empty()) trail.push_back(step.second ? e.second : e.first);
+        trail.push_back(step.second ? e.first : e.second);
+    }
+    if (!trail.empty()) emit(trail);
+}
+
+// Odcinki części [lo, hi) grafu podzielonego na zakresy wierzchołków. Część zna pełne wiersze
+// swoich wierzchołków: krawędzie wewnętrzne rozkłada na ślady, a krawędzie do innych części,
+// których mniejszy koniec należy do niej, zgłasza jako odcinki długości 1. Wierzchołki
+// o nieparzystym stopniu wewnętrznym łączy w pary krawędziami pozornymi i na nich tnie obwody;
+// dalej tnie na wierzchołkach brzegowych i tam, gdzie stykają się rozłączne dotąd grupy
+// odcinków. Dzięki temu końce odcinków wszystkich części tworzą spójny multigraf eulerowski,
+// o ile taki jest cały graf
+inline vector<vector<int>> partitionTrails(const CsrView& g, int lo, int hi) {
+    int k = hi - lo;
+    vector<pair<int, int>> edges;
+    vector<vector<int>> crossing;
+    vector<char> cut(k, 0);
+    vector<int> internalDegree(k, 0);
+    for (int u = lo; u < hi; ++u) {
+        bool loopHalf = false;
+        for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+            int v = g.target[i];
+            if (v < lo || v >= hi) {
+                cut[u - lo] = 1;
+                if (u < v) crossing.push_back({ u, v });
+                continue;
+            }
+            ++internalDegree[u - lo];
+            if (v > u || (v == u && (loopHalf = !loopHalf))) edges.push_back({ u - lo, v - lo });
+        }
+    }
+    size_t real = edges.size();
+    addVirtualEdges(edges, k, [&](int v) { return (internalDegree[v] & 1) != 0; });
+
+    vector<vector<int>> trails;
+    for (auto& circuit : eulerCircuits(k, edges))
+        splitAtVirtualEdges(circuit, edges, real, [&](vector<int>& trail) {
+            for (int& v : trail) v += lo;
+            trails.push_back(move(trail));
+        });
+
+    // Cięcie na zaznaczonych wierzchołkach wewnątrz odcinków
+    auto split = [&](vector<vector<int>>& list) {
+        vector<vector<int>> pieces;
+        for (auto& trail : list) {
+            size_t from = 0;
+            for (size_t j = 1; j + 1 < trail.size(); ++j)
+                if (cut[trail[j] - lo]) {
+                    pieces.emplace_back(trail.begin() + from, trail.begin() + j + 1);
+                    from = j;
+                }
+            pieces.emplace_back(trail.begin() + from, trail.end());
+        }
+        list = move(pieces);
+    };
+    split(trails);
+
+    // Odcinki, które mają wspólny wierzchołek tylko we wnętrzu, łączy dodatkowe cięcie w nim
+    vector<int> group(trails.size());
+    for (size_t s = 0; s < trails.size(); ++s) group[s] = (int)s;
+    auto find = [&](int s) {
+        while (group[s] != s) s = group[s] = group[group[s]];
+        return s;
+    };
+    vector<int> seen(k, -1);
+    fill(cut.begin(), cut.end(), 0);
+    bool spliced = false;
+    for (size_t s = 0; s < trails.size(); ++s)
+        for (int v : trails[s]) {
+            int& other = seen[v - lo];
+            if (other < 0) { other = (int)s; continue; }
+            int a = find(other), b = find((int)s);
+            if (a == b) continue;
+            group[a] = b;
+            cut[v - lo] = 1;
+            spliced = true;
+        }
+    if (spliced) split(trails);
+
+    for (auto& c : crossing) trails.push_back(move(c));
+    return trails;
+}
+
+// Koordynator: odcinki są krawędziami multigrafu na swoich końcach, a jego obwód Eulera wyznacza
+// kolejność odcinków i kierunek przejścia (true = od końca do początku). Pusty wynik: odcinki
+// nie składają się w jeden obwód (graf niespójny albo z wierzchołkiem nieparzystym)
+inline vector<pair<int, bool>> stitchTrails(const vector<pair<int, int>>& ends) {
+    unordered_map<int, int> id;
+    vector<pair<int, int>> edges;
+    vector<int> degree;
+    auto compact = [&](int v) {
+        auto it = id.find(v);
+        if (it != id.end()) return it->second;
+        degree.push_back(0);
+        return id[v] = (int)degree.size() - 1;
+    };
+    for (auto& e : ends) {
+        edges.push_back({ compact(e.first), compact(e.second) });
+        ++degree[edges.back().first];
+        ++degree[edges.back().second];
+    }
+    for (int d : degree)
+        if (d & 1) return {};
+    vector<vector<pair<int, bool>>> circuits = eulerCircuits((int)degree.size(), edges);
+    return circuits.size() == 1 ? circuits[0] : vector<pair<int, bool>>();
+}
+
+// Najmniejsze pokrycie krawędzi śladami (np. ruchy pisaka bez odrywania): składowa z 2k
+// wierzchołkami nieparzystymi daje dokładnie k śladów, składowa bez nich - jeden obwód.
+// Nieparzyste wierzchołki łączymy w pary krawędziami pozornymi, obwód Eulera tniemy na nich.
+// Składowe liczone równolegle, każdy ślad trafia do emit(ślad) od razu po wyznaczeniu
+// (wywołania szeregowane mutexem). Czas O(V + E); wynik: liczba śladów
+template <class Emit>
+long long minimumTrailCover(const CsrView& g, Emit emit, unsigned threads = 0) {
+    vector<int> labels = connectedComponents(g, threads);
+    vector<int> index(g.n, -1), start(1, 0), members;
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) > 0 && labels[v] == v) {
+            index[v] = (int)start.size() - 1;
+            start.push_back(0);
+        }
+    int components = (int)start.size() - 1;
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) > 0) ++start[index[labels[v]] + 1];
+    for (int c = 0; c < components; ++c) start[c + 1] += start[c];
+    members.resize(start.back());
+    vector<int> fillPos(start.begin(), start.end() - 1), local(g.n, -1);
+    for (int v = 0; v < g.n; ++v)
+        if (g.degree(v) > 0) {
+            int c = index[labels[v]];
+            local[v] = fillPos[c] - start[c];
+            members[fillPos[c]++] = v;
+        }
+
+    mutex emitLock;
+    atomic<long long> trails(0);
+    parallelFor(0, components, threads, [&](long long lo, long long hi) {
+        for (long long c = lo; c < hi; ++c) {
+            const int* vertex = members.data() + start[c];
+            int k = start[c + 1] - start[c];
+            vector<pair<int, int>> edges;
+            for (int j = 0; j < k; ++j) {
+                int v = vertex[j];
+                bool loopHalf = false;
+                for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+                    int u = g.target[i];
+                    if (u > v || (u == v && (loopHalf = !loopHalf))) edges.push_back({ j, local[u] });
+                }
+            }
+            size_t real = edges.size();
+            addVirtualEdges(edges, k, [&](int j) { return (g.degree(vertex[j]) & 1) != 0; });
+
+            vector<vector<pair<int, bool>>> circuits = eulerCircuits(k, edges);
+            if (circuits.empty()) continue;
+            splitAtVirtualEdges(circuits[0], edges, real, [&](vector<int>& trail) {
+                for (int& v : trail) v = vertex[v];
+                ++trails;
+                lock_guard<mutex> lk(emitLock);
+                emit(trail);
+            });
+        }
+    }, 1);
+    return trails;
+}
+
+// ---------------------------------------------------------------------------
+// Tablice odpowiedzi Hamiltona dla małych grafów
+// ---------------------------------------------------------------------------
+
+// Numer bitu krawędzi i-j (i < j) w masce grafu. Graf na n wierzchołkach zajmuje n(n-1)/2
+// najmłodszych bitów
+inline int pairBit(int i, int j) { return j * (j - 1) / 2 + i; }
+
+// Maska grafu prostego o tych samych wierzchołkach (pętle i krawędzie wielokrotne pominięte), n <= 11
+inline uint64_t tinyGraphMask(const CsrView& g) {
+    uint64_t mask = 0;
+    for (int v = 0; v < g.n; ++v)
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+            if (g.target[i] < v) mask |= 1ULL << pairBit(g.target[i], v);
+    return mask;
+}
+
+// Dla każdego grafu etykietowanego na n <= limit wierzchołkach: czy ma cykl Hamiltona i czy ma
+// ścieżkę Hamiltona (bit na graf w każdej tablicy). Obie własności są monotoniczne - dodanie
+// krawędzi ich nie psuje - więc tablica to domknięcie w górę masek samych cykli (n!/2n) albo
+// samych ścieżek (n!/2): jedno przejście na bit krawędzi, E * 2^E / 64 operacji na słowach.
+// Tablica dla danego n powstaje przy pierwszym zapytaniu (n = 8: 2 x 32 MB, ułamek sekundy)
+// i może być zapisana do pliku, a przy następnym uruchomieniu z niego wczytana
+class TinyHamiltonTables {
+public:
+    static const int limit = 8;
+
+    static TinyHamiltonTables& current() {
+        static TinyHamiltonTables tables;
+        return tables;
+    }
+
+    // Przed pierwszym zapytaniem. Niepusty cachePrefix: tablice w plikach <cachePrefix><n>.bin
+    void configure(int maxVertices, const string& cachePrefix = "") {
+        lock_guard<mutex> lk(lock);
+        maxN = max(0, min(maxVertices, (int)limit));
+        prefix = cachePrefix;
+        for (auto& t : tables) {
+            t.ready = false;
+            t.cycle.clear();
+            t.path.clear();
+        }
+    }
+
+    int maxVertices() const { return maxN; }
+    bool covers(int n) const { return n >= 3 && n <= maxN; }
+
+    bool hasCycle(int n, uint64_t mask) { return test(table(n).cycle, mask); }
+    bool hasPath(int n, uint64_t mask) { return test(table(n).path, mask); }
+
+private:
+    struct Table {
+        atomic<bool> ready{ false };
+        vector<uint64_t> cycle, path;
+    };
+
+    static bool test(const vector<uint64_t>& bits, uint64_t mask) { return bits[mask >> 6] >> (mask & 63) & 1; }
+    static void set(vector<uint64_t>& bits, uint64_t mask) { bits[mask >> 6] |= 1ULL << (mask & 63); }
+
+    const Table& table(int n) {
+        Table& t = tables[n];
+        if (!t.ready.load(memory_order_acquire)) {
+            lock_guard<mutex> lk(lock);
+            if (!t.ready.load(memory_order_relaxed)) {
+                if (!load(n, t)) {
+                    build(n, t);
+                    save(n, t);
+                }
+                t.ready.store(true, memory_order_release);
+            }
+        }
+        return t;
+    }
+
+    static void build(int n, Table& t) {
+        int edges = n * (n - 1) / 2;
+        size_t words = (size_t)1 << max(0, edges - 6);
+        t.cycle.assign(words, 0);
+        t.path.assign(words, 0);
+        vector<int> order(n);
+        for (int i = 0; i < n; ++i) order[i] = i;
+        // Każda ścieżka raz (początek < koniec); ścieżki z początkiem 0 domknięte dają wszystkie cykle
+        do {
+            if (order[0] > order[n - 1]) continue;
+            uint64_t mask = 0;
+            for (int i = 0; i + 1 < n; ++i)
+                mask |= 1ULL << pairBit(min(order[i], order[i + 1]), max(order[i], order[i + 1]));
+            set(t.path, mask);
+            if (order[0] == 0) set(t.cycle, mask | 1ULL << pairBit(0, order[n - 1]));
+        } while (next_permutation(order.begin(), order.end()));
+        closeUpward(t.cycle, edges);
+        closeUpward(t.path, edges);
+    }
+
+    // Po przejściu bitu b: zbiór zawiera maskę z b, jeśli zawierał ją bez b
+    static void closeUpward(vector<uint64_t>& bits, int edges) {
+        static const uint64_t low[6] = { 0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+                                         0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL };
+        for (int b = 0; b < min(edges, 6); ++b)
+            for (auto& w : bits) w |= (w & low[b]) << (1 << b);
+        for (int b = 6; b < edges; ++b) {
+            size_t stride = (size_t)1 << (b - 6);
+            for (size_t base = 0; base < bits.size(); base += 2 * stride)
+                for (size_t i = 0; i < stride; ++i) bits[base + stride + i] |= bits[base + i];
+        }
+    }
+
+    // Plik: "HTAB", n (int32), słowa tablicy cykli, słowa tablicy ścieżek
+    bool load(int n, Table& t) const {
+        if (prefix.empty()) return false;
+        ifstream in(prefix + to_string(n) + ".bin", ios::binary);
+        char magic[4];
+        int32_t stored = 0;
+        if (!in.read(magic, 4) || string(magic, 4) != "HTAB" || !in.read((char*)&stored, sizeof(stored)) || stored != n)
+            return false;
+        size_t words = (size_t)1 << max(0, n * (n - 1) / 2 - 6);
+        t.cycle.resize(words);
+        t.path.resize(words);
+        return (bool)in.read((char*)t.cycle.data(), words * sizeof(uint64_t)) &&
+               (bool)in.read((char*)t.path.data(), words * sizeof(uint64_t));
+    }
+
+    void save(int n, const Table& t) const {
+        if (prefix.empty()) return;
+        ofstream out(prefix + to_string(n) + ".bin", ios::binary);
+        int32_t stored = n;
+        out.write("HTAB", 4);
+        out.write((const char*)&stored, sizeof(stored));
+        out.write((const char*)t.cycle.data(), t.cycle.size() * sizeof(uint64_t));
+        out.write((const char*)t.path.data(), t.path.size() * sizeof(uint64_t));
+    }
+
+    mutex lock;
+    int maxN = 7;
+    string prefix;
+    Table tables[limit + 1];
+};
+
+inline bool tinyCycleFrom(const uint32_t* adj, int n, int v, uint32_t visited, vector<int>& path) {
+    path.push_back(v);
+    visited |= 1u << v;
+    if ((int)path.size() == n && (adj[v] & 1)) {
+        path.push_back(0);
+        return true;
+    }
+    for (uint32_t next = adj[v] & ~visited; next; next &= next - 1)
+        if (tinyCycleFrom(adj, n, lowestBit(next), visited, path)) return true;
+    path.pop_back();
+    return false;
+}
+
+// Liść przeszukiwania: odpowiedź z tablicy, a przy "tak" świadek z przeszukiwania masek
+// (znalezienie jest pewne, więc bez nawrotów po całym drzewie). Cykl od wierzchołka 0
+inline SolveStatus tinyHamilton(const CsrView& g, vector<int>& path) {
+    path.clear();
+    if (!TinyHamiltonTables::current().hasCycle(g.n, tinyGraphMask(g))) return SolveStatus::NotFound;
+    uint32_t adj[TinyHamiltonTables::limit] = {};
+    for (int v = 0; v < g.n; ++v)
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+            if (g.target[i] != v) adj[v] |= 1u << g.target[i];
+    tinyCycleFrom(adj, g.n, 0, 0, path);
+    return SolveStatus::Found;
+}
+
+// Przeszukiwanie z nawrotami w tej samej kolejności co Graph::hamiltonUtil
+inline bool csrHamiltonUtil(const CsrView& g, int v, vector<char>& visited, vector<int>& path, int depth,
+                            SearchControl* control, const HybridAdjacency* adjacency = nullptr) {
+    if (control) {
+        if (control->shouldStop()) return false;
+        if (depth > control->maxDepth) control->maxDepth = depth;
+        if (control->progress && (control->nodes & 1023) == 0) control->publish(g, path);
+    }
+    path.push_back(v);
+    visited[v] = 1;
+
+    if (depth == g.n) {
+        bool closes = false;
+        if (adjacency) {
+            closes = adjacency->hasEdge(v, path[0]);
+        } else {
+            for (long long i = g.offset[v]; i < g.offset[v + 1] && !closes; ++i)
+                closes = g.target[i] == path[0];
+        }
+        if (closes) {
+            path.push_back(path[0]);
+            return true;
+        }
+    }
+
+    for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+        int u = g.target[i];
+        if (visited[u]) {
+            if (control) ++control->pruned;
+            continue;
+        }
+        if (csrHamiltonUtil(g, u, visited, path, depth + 1, control, adjacency))
+            return true;
+    }
+
+    if (control) ++control->backtracks;
+    visited[v] = 0;
+    path.pop_back();
+    return false;
+}
+
+// Przy dużych grafach domknięcie cyklu sprawdza wiersz bitowy zamiast skanu listy; przy małych
+// nie opłaca się budować struktury (nullptr)
+inline unique_ptr<HybridAdjacency> hamiltonAdjacency(const CsrView& g) {
+    return unique_ptr<HybridAdjacency>(g.n >= 256 ? new HybridAdjacency(g) : nullptr);
+}
+
+// adjacency zbudowane raz dla grafu trzymanego w pamięci (demon, uchwyt biblioteki) oszczędza
+// budowania przy każdym zapytaniu; bez niego csrHamilton buduje własne
+inline SolveStatus csrHamilton(const CsrView& g, vector<int>& path, SearchControl* control = nullptr,
+                               const HybridAdjacency* adjacency = nullptr) {
+    path.clear();
+    if (TinyHamiltonTables::current().covers(g.n)) return tinyHamilton(g, path);
+    if (g.n == 0 || !hamiltonPrescreen(g)) return SolveStatus::NotFound;
+    vector<char> visited(g.n, 0);
+    unique_ptr<HybridAdjacency> owned = adjacency ? nullptr : hamiltonAdjacency(g);
+    bool found = csrHamiltonUtil(g, 0, visited, path, 1, control, adjacency ? adjacency : owned.get());
+    if (control && control->progress) control->publish(g, path);
+    if (found) return SolveStatus::Found;
+    if (control && control->stopped) return SolveStatus::Aborted;
+    return SolveStatus::NotFound;
+}
+
+// Przeszukuje tylko poddrzewo ścieżek zaczynających się od prefix (prefix[0] to korzeń cyklu);
+// jednostka pracy przeszukiwania rozproszonego. Wiersze bitowe można przekazać z zewnątrz,
+// żeby nie budować ich dla każdej jednostki od nowa
+inline SolveStatus csrHamiltonFrom(const CsrView& g, const vector<int>& prefix, vector<int>& path,
+                                   SearchControl* control = nullptr, const HybridAdjacency* adjacency = nullptr) {
+    path.clear();
+    if (prefix.empty() || (int)prefix.size() > g.n) return SolveStatus::NotFound;
+    vector<char> visited(g.n, 0);
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (prefix[i] < 0 || prefix[i] >= g.n || visited[prefix[i]]) return SolveStatus::NotFound;
+        visited[prefix[i]] = 1;
+        if (i + 1 < prefix.size()) path.push_back(prefix[i]);
+    }
+    visited[prefix.back()] = 0;
+    bool found = csrHamiltonUtil(g, prefix.back(), visited, path, (int)prefix.size(), control, adjacency);
+    if (found) return SolveStatus::Found;
+    path.clear();
+    if (control && control->stopped) return SolveStatus::Aborted;
+    return SolveStatus::NotFound;
+}
+
+// Przeszukiwanie Hamiltona, które można przerwać i wznowić: zamiast rekurencji jawny stos ramek
+// (ścieżka i numer następnej półkrawędzi na każdym poziomie), kolejność węzłów taka sama jak
+// w csrHamiltonUtil. Zawieszone przeszukiwanie to tylko te tablice, więc planista może
+// przełączać tysiące zapytań na kilku wątkach
+class HamiltonSearch {
+public:
+    explicit HamiltonSearch(const CsrView& graph, const HybridAdjacency* adjacency = nullptr)
+        : g(graph), rows(adjacency), visited(graph.n, 0) {
+        if (g.n == 0 || !hamiltonPrescreen(g)) finished = true;
+        else enter(0);
+    }
+
+    // Co najwyżej budget nowych węzłów drzewa; true, gdy przeszukiwanie jest zakończone
+    bool resume(long long budget) {
+        while (!finished && budget > 0) {
+            int v = path.back();
+            long long& i = next.back();
+            while (i < g.offset[v + 1] && visited[g.target[i]]) ++i;
+            if (i == g.offset[v + 1]) {
+                visited[v] = 0;
+                path.pop_back();
+                next.pop_back();
+                finished = path.empty();
+                continue;
+            }
+            enter(g.target[i++]);
+            --budget;
+        }
+        return finished;
+    }
+
+    bool done() const { return finished; }
+    SolveStatus status() const { return found ? SolveStatus::Found : SolveStatus::NotFound; }
+    vector<int> cycle() const { return found ? path : vector<int>(); }
+    long long nodes() const { return visitedNodes; }
+
+    // Pamięć stanu zawieszonego przeszukiwania
+    size_t stateBytes() const {
+        return path.capacity() * sizeof(int) + next.capacity() * sizeof(long long) + visited.capacity();
+    }
+
+private:
+    void enter(int v) {
+        ++visitedNodes;
+        path.push_back(v);
+        next.push_back(g.offset[v]);
+        visited[v] = 1;
+        if ((int)path.size() == g.n && closes(v)) {
+            path.push_back(path[0]);
+            found = finished = true;
+        }
+    }
+
+    bool closes(int v) const {
+        if (rows) return rows->hasEdge(v, path[0]);
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+            if (g.target[i] == path[0]) return true;
+        return false;
+    }
+
+    CsrView g;
+    const HybridAdjacency* rows;
+    vector<char> visited;
+    vector<int> path;
+    vector<long long> next;
+    long long visitedNodes = 0;
+    bool found = false, finished = false;
+};
+
+// ---------------------------------------------------------------------------
+// Kernelizacja przed przeszukiwaniem Hamiltona
+// ---------------------------------------------------------------------------
+
+// Graf zredukowany z zachowaniem odpowiedzi. Wierzchołek zredukowany odpowiada jednemu
+// wierzchołkowi oryginału albo całemu łańcuchowi wymuszonych krawędzi (expansion)
+struct HamiltonKernel {
+    bool infeasible = false;
+    vector<int> solved;                 // cykl wymuszony w całości przez same reguły
+    CsrGraph reduced;
+    vector<vector<int>> expansion;      // wierzchołek zredukowany -> wierzchołki oryginału po kolei
+    vector<int> chainStart;             // dla łańcucha: oryginalny sąsiad przy expansion.front()
+    long long forcedEdges = 0, deletedEdges = 0;
+
+    // Cykl w grafie zredukowanym -> cykl w oryginale, zaczynający się od wierzchołka 0
+    vector<int> lift(const vector<int>& cycle) const {
+        vector<int> out;
+        int k = (int)cycle.size() - 1;
+        for (int i = 0; i < k; ++i) {
+            // Sąsiadami łańcucha są tylko jego dwa zwykłe końce, więc poprzednik wyznacza kierunek
+            const vector<int>& part = expansion[cycle[i]];
+            int prev = expansion[cycle[(i + k - 1) % k]][0];
+            if (part.size() == 1 || chainStart[cycle[i]] == prev)
+                out.insert(out.end(), part.begin(), part.end());
+            else
+                out.insert(out.end(), part.rbegin(), part.rend());
+        }
+        rotate(out.begin(), find(out.begin(), out.end(), 0), out.end());
+        out.push_back(out.front());
+        return out;
+    }
+};
+
+// Reguły do punktu stałego: wierzchołek stopnia 2 wymusza obie krawędzie; wierzchołek z dwiema
+// wymuszonymi traci pozostałe; krawędź domykająca wymuszoną ścieżkę krótszą niż n jest usuwana;
+// stopień < 2, trzy wymuszone krawędzie albo wymuszony podcykl oznaczają brak cyklu Hamiltona.
+// Na koniec wnętrze każdej wymuszonej ścieżki zwija się do jednego wierzchołka stopnia 2
+inline HamiltonKernel kernelizeHamilton(const CsrView& g) {
+    HamiltonKernel k;
+    int n = g.n;
+    vector<set<int>> nb(n);
+    for (int v = 0; v < n; ++v)
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+            if (g.target[i] != v) nb[v].insert(g.target[i]);
+
+    vector<vector<int>> forced(n);
+    vector<int> end(n), size(n, 1);
+    for (int v = 0; v < n; ++v) end[v] = v;
+    vector<int> work;
+    for (int v = 0; v < n; ++v) work.push_back(v);
+
+    auto isForced = [&](int u, int v) { return find(forced[u].begin(), forced[u].end(), v) != forced[u].end(); };
+    auto removeEdge = [&](int u, int v) {
+        if (!nb[u].erase(v)) return;
+        nb[v].erase(u);
+        ++k.deletedEdges;
+        work.push_back(u);
+        work.push_back(v);
+    };
+    auto force = [&](int u, int v) {
+        if (isForced(u, v)) return;
+        forced[u].push_back(v);
+        forced[v].push_back(u);
+        ++k.forcedEdges;
+        work.push_back(u);
+        work.push_back(v);
+        int a = end[u], b = end[v];
+        if (a == v) {
+            // Domknięcie ścieżki: poprawne tylko wtedy, gdy obejmuje wszystkie wierzchołki
+            if (size[u] < n) k.infeasible = true;
+            return;
+        }
+        int total = size[a] + size[b];
+        end[a] = b; end[b] = a;
+        size[a] = size[b] = total;
+        if (total < n && nb[a].count(b) && !isForced(a, b)) removeEdge(a, b);
+    };
+
+    while (!work.empty() && !k.infeasible) {
+        int v = work.back();
+        work.pop_back();
+        if (nb[v].size() < 2 || forced[v].size() > 2) { k.infeasible = true; break; }
+        if (nb[v].size() == 2)
+            for (int u : vector<int>(nb[v].begin(), nb[v].end())) force(v, u);
+        if (forced[v].size() == 2) {
+            vector<int> extra;
+            for (int u : nb[v])
+                if (!isForced(v, u)) extra.push_back(u);
+            for (int u : extra) removeEdge(v, u);
+        }
+    }
+    if (k.infeasible) return k;
+
+    // Wymuszony cykl obejmujący cały graf jest od razu rozwiązaniem
+    if (k.forcedEdges == n) {
+        int prev = -1, v = 0;
+        do {
+            k.solved.push_back(v);
+            int next = forced[v][0] == prev ? forced[v][1] : forced[v][0];
+            prev = v;
+            v = next;
+        } while (v != 0);
+        k.solved.push_back(0);
+        return k;
+    }
+
+    // Zwijanie łańcuchów: wnętrze ścieżki (wierzchołki z dwiema wymuszonymi krawędziami)
+    vector<int> id(n, -1);
+    vector<pair<int, int>> edges;
+    for (int v = 0; v < n; ++v) {
+        if (forced[v].size() == 2) continue;
+        id[v] = (int)k.expansion.size();
+        k.expansion.push_back({ v });
+        k.chainStart.push_back(-1);
+    }
+    for (int a = 0; a < n; ++a) {
+        if (forced[a].size() != 1 || forced[forced[a][0]].size() != 2) continue;
+        vector<int> inner;
+        int prev = a, v = forced[a][0];
+        while (forced[v].size() == 2) {
+            inner.push_back(v);
+            int next = forced[v][0] == prev ? forced[v][1] : forced[v][0];
+            prev = v;
+            v = next;
+        }
+        if (a > v) continue;  // każdy łańcuch tylko raz, od końca o mniejszym numerze
+        int c = (int)k.expansion.size();
+        k.expansion.push_back(inner);
+        k.chainStart.push_back(a);
+        edges.push_back({ id[a], c });
+        edges.push_back({ c, id[v] });
+    }
+    for (int u = 0; u < n; ++u)
+        for (int v : nb[u])
+            if (u < v && id[u] >= 0 && id[v] >= 0) edges.push_back({ id[u], id[v] });
+    k.reduced = CsrGraph::fromEdges((int)k.expansion.size(), edges);
+    return k;
+}
+
+// Hamilton z kernelizacją: redukcja, przeszukiwanie mniejszego grafu, przeniesienie cyklu na oryginał
+inline SolveStatus kernelizedHamilton(const CsrView& g, vector<int>& path, SearchControl* control = nullptr) {
+    path.clear();
+    if (g.n < 3) return csrHamilton(g, path, control);
+    HamiltonKernel k = kernelizeHamilton(g);
+    if (k.infeasible) return SolveStatus::NotFound;
+    if (!k.solved.empty()) {
+        path = k.solved;
+        return SolveStatus::Found;
+    }
+    vector<int> reducedCycle;
+    SolveStatus s = csrHamilton(k.reduced.view(), reducedCycle, control);
+    if (s == SolveStatus::Found) path = k.lift(reducedCycle);
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Dziel i zwyciężaj przez separatory dwuwierzchołkowe
+// ---------------------------------------------------------------------------
+
+// Wynik Tarjana: czy graf (bez wierzchołka skip) jest spójny i który punkt artykulacji
+// dzieli go najrówniej (balance = rozmiar mniejszej części)
+struct ArticulationScan {
+    bool connected = true;
+    int best = -1;
+    int balance = 0;
+};
+
+inline ArticulationScan scanArticulation(const CsrView& g, int skip = -1) {
+    ArticulationScan r;
+    int total = g.n - (skip >= 0);
+    int root = skip == 0 ? 1 : 0;
+    if (total <= 1) return r;
+    vector<int> disc(g.n, -1), low(g.n, 0), sub(g.n, 1);
+    vector<long long> it(g.n);
+    vector<pair<int, int>> stack;  // (wierzchołek, numer krawędzi od rodzica)
+    int time = 0, rootChildren = 0, firstRootChild = -1;
+    disc[root] = low[root] = time++;
+    it[root] = g.offset[root];
+    stack.push_back({ root, -1 });
+    while (!stack.empty()) {
+        int v = stack.back().first, viaEdge = stack.back().second;
+        if (it[v] < g.offset[v + 1]) {
+            long long i = it[v]++;
+            int u = g.target[i];
+            if (u == skip || g.edgeId[i] == viaEdge) continue;
+            if (disc[u] < 0) {
+                disc[u] = low[u] = time++;
+                it[u] = g.offset[u];
+                stack.push_back({ u, g.edgeId[i] });
+                if (v == root && ++rootChildren == 1) firstRootChild = u;
+            } else {
+                low[v] = min(low[v], disc[u]);
+            }
+            continue;
+        }
+        stack.pop_back();
+        if (stack.empty()) break;
+        int p = stack.back().first;
+        low[p] = min(low[p], low[v]);
+        sub[p] += sub[v];
+        if (p != root && low[v] >= disc[p]) {
+            int part = min(sub[v], total - 1 - sub[v]);
+            if (r.best < 0 || part > r.balance) { r.best = p; r.balance = part; }
+        }
+    }
+    r.connected = time == total;
+    if (rootChildren > 1) {
+        int part = min(sub[firstRootChild], total - 1 - sub[firstRootChild]);
+        if (r.best < 0 || part > r.balance) { r.best = root; r.balance = part; }
+    }
+    return r;
+}
+
+// Część grafu po podziale: G[C ∪ {x, y}] bez krawędzi x-y, z dodatkowym wierzchołkiem z
+// sąsiadującym tylko z x i y. Cykl Hamiltona w części <=> ścieżka Hamiltona x..y pokrywająca C
+struct SeparatorPiece {
+    vector<int> original;  // lokalny -> oryginalny; 0 = x, 1 = y, ostatni = z (brak oryginału)
+    CsrGraph graph;
+};
+
+// Ścieżka x..y z cyklu części (bez z), w numeracji oryginału
+inline vector<int> pieceSpan(const SeparatorPiece& piece, const vector<int>& cycle) {
+    int z = piece.graph.n - 1, k = (int)cycle.size() - 1;
+    int at = (int)(find(cycle.begin(), cycle.end() - 1, z) - cycle.begin());
+    vector<int> span;
+    for (int s = 1; s < k; ++s) span.push_back(piece.original[cycle[(at + s) % k]]);
+    if (span.front() != piece.original[0]) reverse(span.begin(), span.end());
+    return span;
+}
+
+// Wierzchołki x, y przechodzi się dokładnie raz, więc cykl to dwie rozłączne ścieżki x..y
+// i każda składowa G - {x, y} leży w całości na jednej z nich: przy więcej niż dwóch
+// składowych cyklu nie ma, przy dwóch obie części rozwiązuje się niezależnie (równolegle).
+// spare to wolne wątki wspólne dla całej rekursji: druga część dostaje własny wątek tylko,
+// gdy jakiś jest wolny, więc głębokie drzewo separatorów nie mnoży wątków ponad budżet
+inline SolveStatus separatorSearch(const CsrView& g, vector<int>& path, SearchControl* control, atomic<int>& spare) {
+    path.clear();
+    const int smallest = 8;
+    if (g.n < smallest) return kernelizedHamilton(g, path, control);
+    ArticulationScan whole = scanArticulation(g);
+    if (!whole.connected || whole.best >= 0) return SolveStatus::NotFound;
+
+    int x = -1, y = -1, balance = 1;
+    for (int v = 0; v < g.n; ++v) {
+        ArticulationScan s = scanArticulation(g, v);
+        if (s.best >= 0 && s.balance > balance) { x = v; y = s.best; balance = s.balance; }
+    }
+    // Separator z pojedynczym wierzchołkiem po jednej stronie nie zmniejsza problemu
+    if (x < 0) return kernelizedHamilton(g, path, control);
+
+    vector<int> comp(g.n, -1);
+    comp[x] = comp[y] = -2;
+    int components = 0;
+    for (int s = 0; s < g.n; ++s) {
+        if (comp[s] != -1) continue;
+        if (components == 2) return SolveStatus::NotFound;
+        vector<int> queue = { s };
+        comp[s] = components;
+        for (size_t q = 0; q < queue.size(); ++q)
+            for (long long i = g.offset[queue[q]]; i < g.offset[queue[q] + 1]; ++i)
+                if (comp[g.target[i]] == -1) { comp[g.target[i]] = components; queue.push_back(g.target[i]); }
+        ++components;
+    }
+
+    SeparatorPiece pieces[2];
+    for (int c = 0; c < 2; ++c) {
+        vector<int> local(g.n, -1);
+        SeparatorPiece& piece = pieces[c];
+        piece.original = { x, y };
+        local[x] = 0; local[y] = 1;
+        for (int v = 0; v < g.n; ++v)
+            if (comp[v] == c) { local[v] = (int)piece.original.size(); piece.original.push_back(v); }
+        int z = (int)piece.original.size();
+        piece.original.push_back(-1);
+        vector<pair<int, int>> edges = { { z, 0 }, { z, 1 } };
+        for (int v = 0; v < g.n; ++v)
+            for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+                int u = g.target[i];
+                if (v < u && local[v] >= 0 && local[u] >= 0 && (comp[v] == c || comp[u] == c))
+                    edges.push_back({ local[v], local[u] });
+            }
+        piece.graph = CsrGraph::fromEdges(z + 1, edges);
+    }
+
+    // Każda część ma własny SearchControl; odpowiedź "brak" w jednej przerywa drugą
+    SearchControl controls[2];
+    vector<int> cycles[2];
+    SolveStatus status[2];
+    for (auto& c : controls) {
+        c.parent = control;
+        if (control) c.deadline = control->deadline;
+    }
+    auto solvePiece = [&](int c) {
+        status[c] = separatorSearch(pieces[c].graph.view(), cycles[c], &controls[c], spare);
+        if (status[c] == SolveStatus::NotFound) controls[1 - c].cancelled = true;
+    };
+    bool split = min(pieces[0].graph.n, pieces[1].graph.n) >= 16;
+    int available = spare.load();
+    while (split && available > 0 && !spare.compare_exchange_weak(available, available - 1)) {}
+    if (split && available > 0) {
+        thread other(solvePiece, 1);
+        solvePiece(0);
+        other.join();
+        ++spare;
+    } else {
+        solvePiece(0);
+        if (status[0] == SolveStatus::Found) solvePiece(1);
+        else status[1] = SolveStatus::Aborted;
+    }
+    if (status[0] == SolveStatus::NotFound || status[1] == SolveStatus::NotFound) return SolveStatus::NotFound;
+    if (status[0] != SolveStatus::Found || status[1] != SolveStatus::Found) return SolveStatus::Aborted;
+
+    vector<int> forward = pieceSpan(pieces[0], cycles[0]), back = pieceSpan(pieces[1], cycles[1]);
+    path = forward;
+    path.insert(path.end(), back.rbegin() + 1, back.rend() - 1);
+    rotate(path.begin(), find(path.begin(), path.end(), 0), path.end());
+    path.push_back(path.front());
+    return SolveStatus::Found;
+}
+
+// threads: łączna liczba wątków przeszukiwania (0 = wszystkie rdzenie)
+inline SolveStatus separatorHamilton(const CsrView& g, vector<int>& path, SearchControl* control = nullptr,
+                                     unsigned threads = 0) {
+    atomic<int> spare((int)defaultThreads(threads) - 1);
+    return separatorSearch(g, path, control, spare);
+}
+
+// ---------------------------------------------------------------------------
+// Klasy grafów, w których cykl Hamiltona wyznacza się bez przeszukiwania
+// ---------------------------------------------------------------------------
+
+// Graf prosty o tych samych wierzchołkach: bez pętli i krawędzi wielokrotnych. Przy n >= 3
+// nie zmienia to odpowiedzi, a rozpoznawanie klas zakłada graf prosty
+inline CsrGraph simpleCsr(const CsrView& g) {
+    vector<pair<int, int>> edges;
+    vector<int> seen(g.n, -1);
+    for (int u = 0; u < g.n; ++u)
+        for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+            int v = g.target[i];
+            if (v <= u || seen[v] == u) continue;
+            seen[v] = u;
+            edges.push_back({ u, v });
+        }
+    return CsrGraph::fromEdges(g.n, edges);
+}
+
+// LexBFS przez podział na klasy (listy dwukierunkowe). Remisy rozstrzyga rank: wygrywa mniejszy.
+// Każda klasa jest posortowana po rank, bo sąsiadów piwota przenosimy w kolejności rank;
+// to sortowanie daje O(m log d) zamiast O(n + m). LexBFS+ to rank odwrócony do poprzedniego porządku
+inline vector<int> lexBfs(const CsrView& g, const vector<int>& rank) {
+    int n = g.n;
+    vector<int> order, byRank(n), prevV(n, -1), nextV(n, -1), cls(n, 0), neighbours;
+    vector<int> head(1, -1), tail(1, -1), prevC(1, -1), nextC(1, -1), splitOf(1, -1), splitStamp(1, -1);
+    vector<char> visited(n, 0);
+    for (int v = 0; v < n; ++v) byRank[rank[v]] = v;
+    auto append = [&](int v, int c) {
+        cls[v] = c;
+        prevV[v] = tail[c];
+        nextV[v] = -1;
+        if (tail[c] >= 0) nextV[tail[c]] = v; else head[c] = v;
+        tail[c] = v;
+    };
+    for (int v : byRank) append(v, 0);
+
+    int first = 0;
+    auto detach = [&](int v) {
+        int c = cls[v];
+        if (prevV[v] >= 0) nextV[prevV[v]] = nextV[v]; else head[c] = nextV[v];
+        if (nextV[v] >= 0) prevV[nextV[v]] = prevV[v]; else tail[c] = prevV[v];
+        if (head[c] >= 0) return;
+        // pusta klasa wypada z listy klas
+        if (prevC[c] >= 0) nextC[prevC[c]] = nextC[c]; else first = nextC[c];
+        if (nextC[c] >= 0) prevC[nextC[c]] = prevC[c];
+    };
+
+    order.reserve(n);
+    for (int step = 0; step < n; ++step) {
+        int v = head[first];
+        order.push_back(v);
+        visited[v] = 1;
+        detach(v);
+        neighbours.clear();
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+            if (!visited[g.target[i]]) neighbours.push_back(g.target[i]);
+        sort(neighbours.begin(), neighbours.end(), [&](int a, int b) { return rank[a] < rank[b]; });
+        for (int w : neighbours) {
+            int c = cls[w];
+            if (splitStamp[c] != step) {
+                // nowa klasa tuż przed c: sąsiedzi piwota mają leksykograficznie większą etykietę
+                int s = (int)head.size();
+                head.push_back(-1); tail.push_back(-1); splitOf.push_back(-1); splitStamp.push_back(-1);
+                prevC.push_back(prevC[c]);
+                nextC.push_back(c);
+                if (prevC[c] >= 0) nextC[prevC[c]] = s; else first = s;
+                prevC[c] = s;
+                splitStamp[c] = step;
+                splitOf[c] = s;
+            }
+            detach(w);
+            append(w, splitOf[c]);
+        }
+    }
+    return order;
+}
+
+// Graf właściwy przedziałowy (przedziały jednostkowe, np. z danych o harmonogramach): porządek
+// z trzech przebiegów LexBFS (Corneil) jest "parasolowy" - domknięte sąsiedztwo każdego wierzchołka
+// to spójny odcinek porządku. Pusty wynik: graf nie jest właściwy przedziałowy
+inline vector<int> properIntervalOrder(const CsrView& g) {
+    int n = g.n;
+    vector<int> rank(n);
+    for (int v = 0; v < n; ++v) rank[v] = v;
+    vector<int> order = lexBfs(g, rank);
+    for (int sweep = 0; sweep < 2; ++sweep) {
+        for (int i = 0; i < n; ++i) rank[order[i]] = n - 1 - i;
+        order = lexBfs(g, rank);
+    }
+    vector<int> pos(n);
+    for (int i = 0; i < n; ++i) pos[order[i]] = i;
+    for (int v = 0; v < n; ++v) {
+        int lo = pos[v], hi = pos[v];
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+            lo = min(lo, pos[g.target[i]]);
+            hi = max(hi, pos[g.target[i]]);
+        }
+        if (hi - lo != g.degree(v)) return vector<int>();
+    }
+    return order;
+}
+
+// W porządku parasolowym brak krawędzi v(i)-v(i+2) oznacza, że v(i+1) rozcina graf, więc cykl
+// istnieje dokładnie wtedy, gdy wszystkie takie krawędzie są; wtedy jest nim v0 v2 v4 ... v5 v3 v1
+inline SolveStatus properIntervalHamilton(const CsrView& g, const vector<int>& order, vector<int>& path) {
+    int n = g.n;
+    vector<int> pos(n);
+    for (int i = 0; i < n; ++i) pos[order[i]] = i;
+    for (int v = 0; v < n; ++v) {
+        int reach = pos[v];
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) reach = max(reach, pos[g.target[i]]);
+        if (reach < min(pos[v] + 2, n - 1)) return SolveStatus::NotFound;
+    }
+    path.clear();
+    for (int i = 0; i < n; i += 2) path.push_back(order[i]);
+    for (int i = n % 2 == 0 ? n - 1 : n - 2; i > 0; i -= 2) path.push_back(order[i]);
+    return SolveStatus::Found;
+}
+
+// Kograf (bez indukowanej ścieżki P4): każdy indukowany podgraf jest niespójny albo ma niespójne
+// dopełnienie. Rekurencja po tym rozkładzie (kodrzewo) wyznacza najmniejsze pokrycie ścieżkami
+// (Lin, Olariu, Pruesse): suma - suma pokryć; złączenie A + B, gdzie pA >= pB, to
+// max(1, pA - |B|) ścieżek, bo ścieżki A przeplatamy kawałkami B. Graf pełny wielodzielny
+// to złączenie zbiorów niezależnych, więc przypadek szczególny
+class CographPaths {
+public:
+    explicit CographPaths(const CsrView& graph) : g(graph), mark(graph.n, -1), stamp(0) {}
+
+    // false: graf nie jest kografem albo rozkład jest za głęboki; wynik w found i path
+    bool cycle(vector<int>& path) {
+        path.clear();
+        found = false;
+        vector<int> all(g.n);
+        for (int v = 0; v < g.n; ++v) all[v] = v;
+        vector<vector<int>> parts;
+        split(all, false, parts);
+        if (parts.size() > 1) {
+            // niespójny: cyklu nie ma, wystarczy sprawdzić, czy składowe są kografami
+            vector<vector<int>> paths;
+            return cover(all, 0, paths);
+        }
+        split(all, true, parts);
+        if (parts.size() < 2) return false;
+
+        // Cykl w A + B to naprzemiennie k ścieżek A i k ścieżek B: k od max(pA, pB) do min(|A|, |B|)
+        vector<vector<int>> a, b;
+        size_t sizeA = 0;
+        for (size_t i = 0; i + 1 < parts.size(); ++i) {
+            vector<vector<int>> sub;
+            if (!cover(parts[i], 1, sub)) return false;
+            a = i == 0 ? move(sub) : join(move(a), sizeA, move(sub), parts[i].size());
+            sizeA += parts[i].size();
+        }
+        if (!cover(parts.back(), 1, b)) return false;
+        size_t k = max(a.size(), b.size());
+        found = g.n >= 3 && k <= min(sizeA, parts.back().size());
+        if (!found) return true;
+        refine(a, k);
+        refine(b, k);
+        for (size_t i = 0; i < k; ++i) {
+            path.insert(path.end(), a[i].begin(), a[i].end());
+            path.insert(path.end(), b[i].begin(), b[i].end());
+        }
+        return true;
+    }
+
+    bool found = false;
+
+private:
+    const CsrView& g;
+    vector<int> mark;
+    int stamp;
+    static const int maxDepth = 1000;  // stos rekurencji: rozkład głębszy traktujemy jak nierozpoznany
+
+    // Składowe G[set] (complement = false) albo dopełnienia G[set]
+    void split(const vector<int>& set, bool complement, vector<vector<int>>& parts) {
+        parts.clear();
+        int inside = ++stamp;
+        for (int v : set) mark[v] = inside;
+        int done = ++stamp;
+        if (!complement) {
+            for (int s : set) {
+                if (mark[s] != inside) continue;
+                parts.push_back({ s });
+                mark[s] = done;
+                for (size_t q = 0; q < parts.back().size(); ++q) {
+                    int v = parts.back()[q];
+                    for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+                        if (mark[g.target[i]] == inside) {
+                            mark[g.target[i]] = done;
+                            parts.back().push_back(g.target[i]);
+                        }
+                }
+            }
+            return;
+        }
+        // BFS w dopełnieniu: nieodwiedzeni, którzy nie są sąsiadami v w G, to jego sąsiedzi w dopełnieniu
+        vector<int> unvisited(set), keep;
+        while (!unvisited.empty()) {
+            parts.push_back({ unvisited.back() });
+            unvisited.pop_back();
+            for (size_t q = 0; q < parts.back().size(); ++q) {
+                int v = parts.back()[q], adjacent = ++stamp;
+                for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+                    mark[g.target[i]] = adjacent;
+                keep.clear();
+                for (int u : unvisited)
+                    if (mark[u] == adjacent) keep.push_back(u);
+                    else parts.back().push_back(u);
+                unvisited.swap(keep);
+            }
+        }
+    }
+
+    bool cover(const vector<int>& set, int depth, vector<vector<int>>& paths) {
+        paths.clear();
+        if (set.size() == 1) {
+            paths.push_back(set);
+            return true;
+        }
+        if (depth > maxDepth) return false;
+        vector<vector<int>> parts;
+        split(set, false, parts);
+        if (parts.size() > 1) {
+            for (auto& part : parts) {
+                vector<vector<int>> sub;
+                if (!cover(part, depth + 1, sub)) return false;
+                for (auto& p : sub) paths.push_back(move(p));
+            }
+            return true;
+        }
+        split(set, true, parts);
+        if (parts.size() < 2) return false;
+        size_t size = 0;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            vector<vector<int>> sub;
+            if (!cover(parts[i], depth + 1, sub)) return false;
+            paths = i == 0 ? move(sub) : join(move(paths), size, move(sub), parts[i].size());
+            size += parts[i].size();
+        }
+        return true;
+    }
+
+    // Dzieli ścieżki, aż będzie ich k (k nie większe niż liczba wierzchołków)
+    static void refine(vector<vector<int>>& paths, size_t k) {
+        for (size_t i = 0; paths.size() < k; ++i)
+            while (paths.size() < k && paths[i].size() > 1) {
+                paths.push_back({ paths[i].back() });
+                paths[i].pop_back();
+            }
+    }
+
+    // Najmniejsze pokrycie złączenia z najmniejszych pokryć części
+    static vector<vector<int>> join(vector<vector<int>> a, size_t sizeA, vector<vector<int>> b, size_t sizeB) {
+        if (a.size() < b.size()) {
+            swap(a, b);
+            swap(sizeA, sizeB);
+        }
+        vector<vector<int>> result(1);
+        size_t k = min(a.size(), sizeB);
+        refine(b, k);
+        // a0 b0 a1 b1 ... : przy pA > |B| każdy kawałek b to jeden wierzchołek łączący dwie ścieżki a
+        for (size_t i = 0; i < k; ++i) {
+            result[0].insert(result[0].end(), a[i].begin(), a[i].end());
+            result[0].insert(result[0].end(), b[i].begin(), b[i].end());
+        }
+        for (size_t i = k; i < a.size(); ++i) {
+            if (i == k) result[0].insert(result[0].end(), a[i].begin(), a[i].end());
+            else result.push_back(move(a[i]));
+        }
+        return result;
+    }
+};
+
+// Rozpoznana klasa grafu, dla której Hamilton ma algorytm wielomianowy
+enum class GraphClass { General, ProperInterval, Cograph };
+
+inline const char* graphClassName(GraphClass c) {
+    return c == GraphClass::ProperInterval ? "właściwy przedziałowy"
+         : c == GraphClass::Cograph ? "kograf" : "ogólny";
+}
+
+// Szybka ścieżka przed przeszukiwaniem: rozpoznanie klasy i odpowiedź z jej algorytmu.
+// General: klasa nierozpoznana, status bez zmian. Cykl zaczyna się od wierzchołka 0
+inline GraphClass hamiltonFastPath(const CsrView& graph, vector<int>& path, SolveStatus& status) {
+    if (graph.n < 3 || !hamiltonPrescreen(graph)) return GraphClass::General;
+    CsrGraph simple = simpleCsr(graph);
+    CsrView g = simple.view();
+    GraphClass result = GraphClass::General;
+    path.clear();
+    // Kograf najpierw: typowy graf odpada już na spójnym dopełnieniu, w O(n + m)
+    CographPaths cograph(g);
+    if (cograph.cycle(path)) {
+        result = GraphClass::Cograph;
+        status = cograph.found ? SolveStatus::Found : SolveStatus::NotFound;
+    } else {
+        vector<int> order = properIntervalOrder(g);
+        if (!order.empty()) {
+            result = GraphClass::ProperInterval;
+            status = properIntervalHamilton(g, order, path);
+        }
+    }
+    if (result != GraphClass::General && status == SolveStatus::Found) {
+        rotate(path.begin(), find(path.begin(), path.end(), 0), path.end());
+        path.push_back(path.front());
+    } else {
+        path.clear();
+    }
+    return result;
+}
+
+// Hamilton z szybkimi ścieżkami; graf spoza rozpoznanych klas idzie do przeszukiwania
+inline SolveStatus classifiedHamilton(const CsrView& g, vector<int>& path, SearchControl* control = nullptr,
+                                      const HybridAdjacency* adjacency = nullptr) {
+    SolveStatus status = SolveStatus::NotFound;
+    if (hamiltonFastPath(g, path, status) != GraphClass::General) return status;
+    return csrHamilton(g, path, control, adjacency);
+}
+
+// ---------------------------------------------------------------------------
+// Hamilton przez SAT: wbudowany solver CDCL
+// ---------------------------------------------------------------------------
+
+// Mały solver CDCL: dwa obserwowane literały na klauzulę, analiza konfliktu do pierwszego
+// punktu dominacji (1UIP) ze skokiem wstecz, VSIDS na kopcu, zapamiętywanie fazy i restarty
+// według ciągu Luby'ego. Literał to 2 * zmienna (+1 dla negacji). Klauzule można dokładać
+// między wywołaniami solve - wyuczone klauzule zostają, więc kolejne wywołania są tańsze
+class SatSolver {
+public:
+    long long conflicts = 0, decisions = 0, propagations = 0;
+
+    int newVar() {
+        int v = (int)assigns.size();
+        assigns.push_back(-1);
+        phase.push_back(1);
+        level.push_back(0);
+        reason.push_back(-1);
+        activity.push_back(0);
+        seen.push_back(0);
+        heapIndex.push_back(-1);
+        watches.resize(2 * assigns.size());
+        heapInsert(v);
+        return v;
+    }
+
+    int vars() const { return (int)assigns.size(); }
+    size_t clauseCount() const { return clauses.size(); }
+
+    static int lit(int var, bool negated = false) { return 2 * var + (negated ? 1 : 0); }
+
+    // false: zbiór klauzul jest już sprzeczny
+    bool addClause(vector<int> lits) {
+        if (!ok) return false;
+        cancelUntil(0);
+        sort(lits.begin(), lits.end());
+        size_t j = 0;
+        for (size_t i = 0; i < lits.size(); ++i) {
+            int value = litValue(lits[i]);
+            if (value == 1 || (i > 0 && lits[i] == (lits[i - 1] ^ 1))) return true;  // spełniona
+            if (value == 0 || (j > 0 && lits[i] == lits[j - 1])) continue;
+            lits[j++] = lits[i];
+        }
+        lits.resize(j);
+        if (lits.empty()) return ok = false;
+        if (lits.size() == 1) {
+            enqueue(lits[0], -1);
+            return ok = propagate() < 0;
+        }
+        attach(move(lits));
+        return true;
+    }
+
+    // Co najwyżej jeden z literałów: pary dla krótkich list, licznik sekwencyjny (Sinz) dla długich
+    bool addAtMostOne(const vector<int>& lits) {
+        bool result = true;
+        if (lits.size() <= 6) {
+            for (size_t a = 0; a < lits.size(); ++a)
+                for (size_t b = a + 1; b < lits.size(); ++b)
+                    result = addClause({ lits[a] ^ 1, lits[b] ^ 1 }) && result;
+            return result;
+        }
+        int prev = newVar();
+        result = addClause({ lits[0] ^ 1, lit(prev) });
+        for (size_t i = 1; i + 1 < lits.size(); ++i) {
+            int s = newVar();
+            result = addClause({ lits[i] ^ 1, lit(s) }) && result;
+            result = addClause({ lit(prev, true), lit(s) }) && result;
+            result = addClause({ lits[i] ^ 1, lit(prev, true) }) && result;
+            prev = s;
+        }
+        return addClause({ lits.back() ^ 1, lit(prev, true) }) && result;
+    }
+
+    // Found: model w value(); NotFound: sprzeczne; Aborted: przerwane przez control
+    SolveStatus solve(SearchControl* control = nullptr) {
+        if (!ok) return SolveStatus::NotFound;
+        cancelUntil(0);
+        for (int restart = 0;; ++restart) {
+            long long budget = 100 * luby(restart), local = 0;
+            for (;;) {
+                int conflict = propagate();
+                if (conflict >= 0) {
+                    ++conflicts;
+                    ++local;
+                    if (trailLim.empty()) {
+                        ok = false;
+                        return SolveStatus::NotFound;
+                    }
+                    learn(conflict);
+                    continue;
+                }
+                if (local >= budget) break;
+                if (control && control->shouldStop()) {
+                    cancelUntil(0);
+                    return SolveStatus::Aborted;
+                }
+                int next = pickBranch();
+                if (next < 0) {
+                    model.assign(assigns.begin(), assigns.end());
+                    cancelUntil(0);
+                    return SolveStatus::Found;
+                }
+                ++decisions;
+                trailLim.push_back((int)trail.size());
+                enqueue(next, -1);
+            }
+            cancelUntil(0);
+        }
+    }
+
+    bool value(int var) const { return model[var] == 1; }
+
+private:
+    bool ok = true;
+    vector<vector<int>> clauses, watches;
+    vector<signed char> assigns, phase, model;
+    vector<int> level, reason, trail, trailLim, heap, heapIndex;
+    vector<double> activity;
+    vector<char> seen;
+    double increment = 1;
+    size_t head = 0;
+
+    int litValue(int l) const { return assigns[l >> 1] < 0 ? -1 : assigns[l >> 1] ^ (l & 1); }
+
+    void enqueue(int l, int from) {
+        assigns[l >> 1] = (signed char)((l & 1) ^ 1);
+        level[l >> 1] = (int)trailLim.size();
+        reason[l >> 1] = from;
+        trail.push_back(l);
+    }
+
+    int attach(vector<int> lits) {
+        int index = (int)clauses.size();
+        watches[lits[0]].push_back(index);
+        watches[lits[1]].push_back(index);
+        clauses.push_back(move(lits));
+        return index;
+    }
+
+    // Numer klauzuli w konflikcie albo -1
+    int propagate() {
+        while (head < trail.size()) {
+            int falseLit = trail[head++] ^ 1;
+            ++propagations;
+            vector<int>& ws = watches[falseLit];
+            size_t i = 0, j = 0;
+            while (i < ws.size()) {
+                int index = ws[i++];
+                vector<int>& c = clauses[index];
+                if (c[0] == falseLit) swap(c[0], c[1]);
+                if (litValue(c[0]) == 1) {
+                    ws[j++] = index;
+                    continue;
+                }
+                bool moved = false;
+                for (size_t k = 2; k < c.size() && !moved; ++k)
+                    if (litValue(c[k]) != 0) {
+                        swap(c[1], c[k]);
+                        watches[c[1]].push_back(index);
+                        moved = true;
+                    }
+                if (moved) continue;
+                ws[j++] = index;
+                if (litValue(c[0]) == 0) {
+                    while (i < ws.size()) ws[j++] = ws[i++];
+                    ws.resize(j);
+                    head = trail.size();
+                    return index;
+                }
+                enqueue(c[0], index);
+            }
+            ws.resize(j);
+        }
+        return -1;
+    }
+
+    // 1UIP: cofamy się po śladzie, aż na bieżącym poziomie zostanie jeden literał konfliktu
+    void learn(int conflict) {
+        vector<int> learnt(1);
+        int current = (int)trailLim.size(), open = 0, p = -1;
+        size_t index = trail.size();
+        do {
+            const vector<int>& c = clauses[conflict];
+            for (size_t k = p < 0 ? 0 : 1; k < c.size(); ++k) {
+                int v = c[k] >> 1;
+                if (seen[v] || level[v] == 0) continue;
+                seen[v] = 1;
+                bump(v);
+                if (level[v] == current) ++open;
+                else learnt.push_back(c[k]);
+            }
+            while (!seen[trail[--index] >> 1]) {}
+            p = trail[index];
+            conflict = reason[p >> 1];
+            seen[p >> 1] = 0;
+        } while (--open > 0);
+        learnt[0] = p ^ 1;
+
+        int backjump = 0;
+        for (size_t k = 1; k < learnt.size(); ++k) seen[learnt[k] >> 1] = 0;
+        // drugi obserwowany literał: z najwyższego poziomu poniżej bieżącego
+        for (size_t k = 2; k < learnt.size(); ++k)
+            if (level[learnt[k] >> 1] > level[learnt[1] >> 1]) swap(learnt[1], learnt[k]);
+        if (learnt.size() > 1) backjump = level[learnt[1] >> 1];
+        cancelUntil(backjump);
+        if (learnt.size() == 1) enqueue(learnt[0], -1);
+        else {
+            int l = learnt[0];
+            enqueue(l, attach(move(learnt)));
+        }
+        increment /= 0.95;
+    }
+
+    void cancelUntil(int target) {
+        if ((int)trailLim.size() <= target) return;
+        for (size_t i = trail.size(); i-- > (size_t)trailLim[target];) {
+            int v = trail[i] >> 1;
+            phase[v] = assigns[v];
+            assigns[v] = -1;
+            reason[v] = -1;
+            if (heapIndex[v] < 0) heapInsert(v);
+        }
+        trail.resize(trailLim[target]);
+        trailLim.resize(target);
+        head = trail.size();
+    }
+
+    // Zmienna o największej aktywności; faza z ostatniego przypisania (na starcie prawda)
+    int pickBranch() {
+        while (!heap.empty()) {
+            int v = heap[0];
+            heapRemoveTop();
+            if (assigns[v] < 0) return lit(v, phase[v] != 1);
+        }
+        return -1;
+    }
+
+    void bump(int v) {
+        if ((activity[v] += increment) > 1e100) {
+            for (double& a : activity) a *= 1e-100;
+            increment *= 1e-100;
+        }
+        if (heapIndex[v] >= 0) heapUp(heapIndex[v]);
+    }
+
+    void heapInsert(int v) {
+        heapIndex[v] = (int)heap.size();
+        heap.push_back(v);
+        heapUp(heapIndex[v]);
+    }
+
+    void heapUp(int i) {
+        int v = heap[i];
+        while (i > 0 && activity[heap[(i - 1) / 2]] < activity[v]) {
+            heap[i] = heap[(i - 1) / 2];
+            heapIndex[heap[i]] = i;
+            i = (i - 1) / 2;
+        }
+        heap[i] = v;
+        heapIndex[v] = i;
+    }
+
+    void heapRemoveTop() {
+        heapIndex[heap[0]] = -1;
+        int v = heap.back();
+        heap.pop_back();
+        if (heap.empty()) return;
+        int i = 0, size = (int)heap.size();
+        for (;;) {
+            int child = 2 * i + 1;
+            if (child >= size) break;
+            if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) ++child;
+            if (activity[heap[child]] <= activity[v]) break;
+            heap[i] = heap[child];
+            heapIndex[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = v;
+        heapIndex[v] = i;
+    }
+
+    // 1, 1, 2, 1, 1, 2, 4, 1, ...
+    static long long luby(int x) {
+        int size = 1, seq = 0;
+        while (size < x + 1) {
+            ++seq;
+            size = 2 * size + 1;
+        }
+        while (size - 1 != x) {
+            size = (size - 1) >> 1;
+            --seq;
+            x %= size;
+        }
+        return 1LL << seq;
+    }
+};
+
+// Hamilton jako SAT: zmienna na łuk u->v ("następnikiem u jest v") - to numer półkrawędzi w CSR.
+// Każdy wierzchołek ma dokładnie jeden następnik i jeden poprzednik, bez cykli dwuelementowych,
+// więc model to rozkład na cykle. Zakazu podcykli nie kodujemy z góry (wykładniczo wiele
+// klauzul): każdy krótki cykl S z modelu dostaje klauzulę "któryś łuk wychodzi z S" i solver
+// liczy dalej z wyuczonymi klauzulami. Dla średnich rzadkich grafów, gdzie DFS tonie
+inline SolveStatus satHamilton(const CsrView& graph, vector<int>& path, SearchControl* control = nullptr) {
+    path.clear();
+    if (graph.n < 3) return csrHamilton(graph, path, control);
+    if (!hamiltonPrescreen(graph)) return SolveStatus::NotFound;
+    CsrGraph simple = simpleCsr(graph);
+    CsrView g = simple.view();
+
+    // Łuk przeciwny: obie półkrawędzie mają ten sam numer krawędzi
+    vector<long long> reverse((size_t)(2 * g.m)), half(g.m, -1);
+    for (long long i = 0; i < 2 * g.m; ++i) {
+        long long& other = half[g.edgeId[i]];
+        if (other < 0) {
+            other = i;
+        } else {
+            reverse[i] = other;
+            reverse[other] = i;
+        }
+    }
+
+    SatSolver solver;
+    for (long long i = 0; i < 2 * g.m; ++i) solver.newVar();
+    bool ok = true;
+    vector<int> out, in;
+    for (int u = 0; u < g.n; ++u) {
+        out.clear();
+        in.clear();
+        for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+            out.push_back(SatSolver::lit((int)i));
+            in.push_back(SatSolver::lit((int)reverse[i]));
+            if (i < reverse[i]) ok = solver.addClause({ SatSolver::lit((int)i, true), SatSolver::lit((int)reverse[i], true) }) && ok;
+        }
+        ok = solver.addClause(out) && solver.addAtMostOne(out) && ok;
+        ok = solver.addClause(in) && solver.addAtMostOne(in) && ok;
+    }
+    if (!ok) return SolveStatus::NotFound;
+
+    vector<int> next(g.n), cycleOf(g.n);
+    for (;;) {
+        SolveStatus s = solver.solve(control);
+        if (s != SolveStatus::Found) return s;
+        for (int u = 0; u < g.n; ++u)
+            for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i)
+                if (solver.value((int)i)) next[u] = g.target[i];
+
+        fill(cycleOf.begin(), cycleOf.end(), -1);
+        vector<vector<int>> cycles;
+        for (int s0 = 0; s0 < g.n; ++s0) {
+            if (cycleOf[s0] >= 0) continue;
+            cycles.push_back({});
+            for (int v = s0; cycleOf[v] < 0; v = next[v]) {
+                cycleOf[v] = (int)cycles.size() - 1;
+                cycles.back().push_back(v);
+            }
+        }
+        if (cycles.size() == 1) {
+            path = cycles[0];
+            path.push_back(path[0]);
+            return SolveStatus::Found;
+        }
+        for (size_t c = 0; c < cycles.size(); ++c) {
+            vector<int> leaving;
+            for (int u : cycles[c])
+                for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i)
+                    if (cycleOf[g.target[i]] != (int)c) leaving.push_back(SatSolver::lit((int)i));
+            if (!solver.addClause(leaving)) return SolveStatus::NotFound;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Algebraiczny test Hamiltona: sumy wyznaczników nad GF(2^64) (Björklund)
+// ---------------------------------------------------------------------------
+
+// Mnożenie w GF(2^64) modulo x^64 + x^4 + x^3 + x + 1: iloczyn bez przeniesień (PCLMULQDQ,
+// gdy kompilator go udostępnia) i redukcja starszej połowy przesunięciami
+inline uint64_t gfMul(uint64_t a, uint64_t b) {
+    uint64_t lo, hi;
+#if defined(__PCLMUL__) || (defined(_MSC_VER) && defined(_M_X64))
+    __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a), _mm_cvtsi64_si128((long long)b), 0);
+    lo = (uint64_t)_mm_cvtsi128_si64(p);
+    hi = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(p, p));
+#else
+    lo = hi = 0;
+    for (int i = 0; i < 64; ++i)
+        if ((b >> i) & 1) {
+            lo ^= a << i;
+            if (i) hi ^= a >> (64 - i);
+        }
+#endif
+    // x^64 = x^4 + x^3 + x + 1; bity, które przy tym wychodzą poza 64, redukujemy drugi raz
+    uint64_t spill = (hi >> 63) ^ (hi >> 61) ^ (hi >> 60);
+    lo ^= hi ^ (hi << 1) ^ (hi << 3) ^ (hi << 4);
+    return lo ^ spill ^ (spill << 1) ^ (spill << 3) ^ (spill << 4);
+}
+
+// a^(2^64 - 2) = a^-1
+inline uint64_t gfInverse(uint64_t a) {
+    uint64_t result = 1;
+    for (int i = 0; i < 63; ++i) {
+        a = gfMul(a, a);
+        result = gfMul(result, a);
+    }
+    return result;
+}
+
+// Wyznacznik macierzy k x k (wierszami) przez eliminację Gaussa; w charakterystyce 2 bez znaków.
+// Macierz jest niszczona
+inline uint64_t gfDeterminant(uint64_t* m, int k) {
+    uint64_t det = 1;
+    for (int c = 0; c < k; ++c) {
+        int pivot = c;
+        while (pivot < k && m[pivot * k + c] == 0) ++pivot;
+        if (pivot == k) return 0;
+        if (pivot != c) swap_ranges(m + pivot * k + c, m + pivot * k + k, m + c * k + c);
+        det = gfMul(det, m[c * k + c]);
+        uint64_t inverse = gfInverse(m[c * k + c]);
+        for (int r = c + 1; r < k; ++r) {
+            uint64_t factor = gfMul(m[r * k + c], inverse);
+            if (factor == 0) continue;
+            for (int j = c + 1; j < k; ++j) m[r * k + j] ^= gfMul(factor, m[c * k + j]);
+        }
+    }
+    return det;
+}
+
+// Suma po wszystkich podzbiorach X etykiet wyznaczników macierzy k x k. Podzbiory idą kodem
+// Graya, więc przejście do następnego to toggle(bit, macierz) - w charakterystyce 2 dodanie
+// i odjęcie składnika to ten sam XOR. Zakresy podzbiorów liczą wątki niezależnie, wyniki się
+// XOR-uje na końcu. Aborted tylko przez control (anulowanie albo termin)
+template <class Toggle>
+SolveStatus gfDeterminantSum(int labels, int k, Toggle toggle, uint64_t& sum, unsigned threads,
+                             SearchControl* control) {
+    atomic<uint64_t> total(0);
+    atomic<bool> stopped(false);
+    long long subsets = 1LL << labels, blocks = min(subsets, 4096LL);
+    parallelFor(0, blocks, threads, [&](long long first, long long last) {
+        long long lo = first * subsets / blocks, hi = last * subsets / blocks;
+        vector<uint64_t> matrix((size_t)k * k, 0), work((size_t)k * k);
+        long long gray = lo ^ (lo >> 1);
+        for (int bit = 0; bit < labels; ++bit)
+            if ((gray >> bit) & 1) toggle(bit, matrix.data());
+        uint64_t local = 0;
+        for (long long i = lo; i < hi && !stopped; ++i) {
+            if (((i - lo) & 255) == 0 && control &&
+                (control->cancelled || steady_clock::now() >= control->deadline))
+                stopped = true;
+            if (i > lo) toggle(lowestBit((uint64_t)i), matrix.data());
+            copy(matrix.begin(), matrix.end(), work.begin());
+            local ^= gfDeterminant(work.data(), k);
+        }
+        total ^= local;
+    }, 1);
+    if (stopped) {
+        if (control) control->stopped = true;
+        return SolveStatus::Aborted;
+    }
+    sum = total;
+    return SolveStatus::Found;
+}
+
+// Test Monte Carlo z błędem jednostronnym w pamięci wielomianowej: Found jest pewne, NotFound
+// myli się z prawdopodobieństwem <= n / 2^64. Wyznacznik w charakterystyce 2 to suma po
+// pokryciach cyklami; etykiety na łukach i suma po ich podzbiorach (włączanie-wyłączanie,
+// znaki znikają) zostawiają pokrycia, w których każda etykieta jest użyta raz. Wagi są
+// symetryczne poza łukami wierzchołka 0, więc pokrycie z więcej niż jednym cyklem znosi się
+// z tym, w którym odwrócono cykl bez wierzchołka 0 (ten z najmniejszym wierzchołkiem) -
+// zostają tylko cykle Hamiltona. Graf dwudzielny: macierz po stronie wierzchołka 0, etykietami
+// są wierzchołki drugiej strony, czas O*(2^(n/2)); pozostałe grafy: n etykiet, O*(2^n)
+inline SolveStatus algebraicHamilton(const CsrView& graph, unsigned threads = 0, SearchControl* control = nullptr,
+                                     unsigned seed = 1) {
+    if (graph.n < 3) {
+        vector<int> path;
+        return csrHamilton(graph, path, control);
+    }
+    if (!hamiltonPrescreen(graph)) return SolveStatus::NotFound;
+    CsrGraph simple = simpleCsr(graph);
+    CsrView g = simple.view();
+    int n = g.n;
+    if (n > 62) return SolveStatus::Aborted;
+    mt19937_64 gen(seed);
+    auto weight = [&] {
+        uint64_t w;
+        while ((w = gen()) == 0) {}
+        return w;
+    };
+
+    vector<int> side(n, -1), queue = { 0 };
+    side[0] = 0;
+    bool bipartite = true;
+    for (size_t q = 0; q < queue.size(); ++q) {
+        int v = queue[q];
+        for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+            int u = g.target[i];
+            if (side[u] < 0) {
+                side[u] = side[v] ^ 1;
+                queue.push_back(u);
+            } else if (side[u] == side[v]) {
+                bipartite = false;
+            }
+        }
+    }
+
+    uint64_t sum = 0;
+    SolveStatus s;
+    if (bipartite) {
+        // Łuk u -> v po stronie wierzchołka 0 to ścieżka u - w - v przez w z drugiej strony
+        vector<int> index(n), members[2];
+        for (int v = 0; v < n; ++v) {
+            index[v] = (int)members[side[v]].size();
+            members[side[v]].push_back(v);
+        }
+        int k = (int)members[0].size();
+        if (k * 2 != n) return SolveStatus::NotFound;
+        // wagi krawędzi w - u dla u po stronie 0 (w kolejności listy w); przy 0 osobno w każdą stronę
+        vector<vector<pair<int, uint64_t>>> into(k), from(k);
+        for (int j = 0; j < k; ++j) {
+            int w = members[1][j];
+            for (long long i = g.offset[w]; i < g.offset[w + 1]; ++i) {
+                int u = index[g.target[i]];
+                uint64_t a = weight();
+                into[j].push_back({ u, a });
+                from[j].push_back({ u, g.target[i] == 0 ? weight() : a });
+            }
+        }
+        s = gfDeterminantSum(k, k, [&](int j, uint64_t* m) {
+            for (auto& a : into[j])
+                for (auto& b : from[j])
+                    if (a.first != b.first) m[a.first * k + b.first] ^= gfMul(a.second, b.second);
+        }, sum, threads, control);
+    } else {
+        // f_l(uv) dla każdej etykiety l, wspólne dla obu półkrawędzi; łuki przy wierzchołku 0 osobno
+        vector<vector<uint64_t>> f(n, vector<uint64_t>((size_t)(2 * g.m)));
+        for (int l = 0; l < n; ++l) {
+            vector<uint64_t> edge((size_t)g.m);
+            for (auto& w : edge) w = weight();
+            for (int u = 0; u < n; ++u)
+                for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i)
+                    f[l][i] = u == 0 || g.target[i] == 0 ? weight() : edge[g.edgeId[i]];
+        }
+        s = gfDeterminantSum(n, n, [&](int l, uint64_t* m) {
+            for (int u = 0; u < n; ++u)
+                for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i) m[u * n + g.target[i]] ^= f[l][i];
+        }, sum, threads, control);
+    }
+    if (s == SolveStatus::Aborted) return s;
+    return sum != 0 ? SolveStatus::Found : SolveStatus::NotFound;
+}
+
+// ---------------------------------------------------------------------------
+// Ścieżka prosta o k wierzchołkach: kodowanie kolorami i sito wąskie
+// ---------------------------------------------------------------------------
+
+// Podgraf indukowany przez keep (wierzchołek keep[j] dostaje numer j), bez pętli. apex dokłada
+// wierzchołek keep.size() sąsiedni ze wszystkimi - ścieżka Hamiltona staje się cyklem Hamiltona
+inline CsrGraph inducedCsr(const CsrView& g, const vector<int>& keep, bool apex = false) {
+    vector<int> index(g.n, -1);
+    for (size_t j = 0; j < keep.size(); ++j) index[keep[j]] = (int)j;
+    vector<pair<int, int>> edges;
+    for (size_t j = 0; j < keep.size(); ++j)
+        for (long long i = g.offset[keep[j]]; i < g.offset[keep[j] + 1]; ++i)
+            if (index[g.target[i]] > (int)j) edges.push_back({ (int)j, index[g.target[i]] });
+    if (apex)
+        for (size_t j = 0; j < keep.size(); ++j) edges.push_back({ (int)j, (int)keep.size() });
+    return CsrGraph::fromEdges((int)keep.size() + (apex ? 1 : 0), edges);
+}
+
+// Sito wąskie (Björklund, Husfeldt, Kaski, Koivisto) nad GF(2^64): wielomian to suma po marszrutach
+// w_1..w_k i bijekcjach l: [k] -> [k] iloczynów x(w_i -> w_i+1) y(w_i, l(i)). Marszruta
+// z powtórzonym wierzchołkiem znosi się z tą samą marszrutą z zamienionymi etykietami pierwszej
+// pary powtórzeń, więc zostają ścieżki proste; łuki u -> v i v -> u mają różne wagi, więc ścieżka
+// i jej odwrócenie się nie znoszą. Sumę po bijekcjach daje suma po podzbiorach X etykiet (znaki
+// znikają): dla ustalonego X marszruty liczy programowanie dynamiczne po k warstwach w O(n + m)
+// na warstwę i pamięci O(n). Podzbiory idą kodem Graya i blokami na wątki jak w gfDeterminantSum.
+// Found jest pewne, NotFound myli się z prawdopodobieństwem <= (2k - 1) / 2^64
+inline SolveStatus kPathSieve(const CsrView& g, int k, unsigned threads, SearchControl* control, mt19937_64& gen) {
+    vector<uint64_t> arc((size_t)(2 * g.m)), label((size_t)g.n * k);
+    for (auto& w : arc) w = gen();
+    for (auto& w : label) w = gen();
+    atomic<uint64_t> total(0);
+    atomic<bool> stopped(false);
+    long long subsets = 1LL << k, blocks = min(subsets, 4096LL);
+    parallelFor(0, blocks, threads, [&](long long first, long long last) {
+        long long lo = first * subsets / blocks, hi = last * subsets / blocks;
+        vector<uint64_t> y(g.n, 0), walks(g.n), next(g.n);
+        auto toggle = [&](int l) {
+            for (int v = 0; v < g.n; ++v) y[v] ^= label[(size_t)v * k + l];
+        };
+        long long gray = lo ^ (lo >> 1);
+        for (int bit = 0; bit < k; ++bit)
+            if ((gray >> bit) & 1) toggle(bit);
+        uint64_t local = 0;
+        for (long long i = lo; i < hi && !stopped; ++i) {
+            if (i > lo) toggle(lowestBit((uint64_t)i));
+            // walks[v]: suma po marszrutach o layer wierzchołkach z etykietami z X, kończących się w v
+            copy(y.begin(), y.end(), walks.begin());
+            for (int layer = 2; layer <= k; ++layer) {
+                if (control && control->expired()) {
+                    stopped = true;
+                    break;
+                }
+                for (int v = 0; v < g.n; ++v) {
+                    uint64_t in = 0;
+                    for (long long e = g.offset[v]; e < g.offset[v + 1]; ++e) in ^= gfMul(arc[e], walks[g.target[e]]);
+                    next[v] = gfMul(in, y[v]);
+                }
+                walks.swap(next);
+            }
+            for (uint64_t w : walks) local ^= w;
+        }
+        total ^= local;
+    }, 1);
+    if (stopped) {
+        if (control) control->stopped = true;
+        return SolveStatus::Aborted;
+    }
+    return total != 0 ? SolveStatus::Found : SolveStatus::NotFound;
+}
+
+// Zbiory kolorów jako bitset 2^k bitów (bit S = zbiór S). Dla każdego S bez koloru c ustawia
+// w dst bit S ∪ {c}: dla c >= 6 to przesunięcie całych słów o 2^(c - 6), niżej - w słowie
+inline void extendByColor(const uint64_t* src, uint64_t* dst, int words, int c) {
+    static const uint64_t without[6] = { 0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+                                         0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL };
+    if (c < 6) {
+        for (int w = 0; w < words; ++w) dst[w] |= (src[w] & without[c]) << (1 << c);
+        return;
+    }
+    int stride = 1 << (c - 6);
+    for (int base = 0; base < words; base += 2 * stride)
+        for (int w = base; w < base + stride; ++w) dst[w + stride] |= src[w];
+}
+
+// DFS z limitem węzłów: szybko znajduje ścieżkę, gdy jest ich dużo (typowy przypadek "tak")
+inline bool kPathDfs(const CsrView& g, int k, const vector<char>& eligible, vector<int>& path, long long budget) {
+    vector<char> onPath(g.n, 0);
+    vector<long long> next;
+    for (int s = 0; s < g.n && budget > 0; ++s) {
+        if (!eligible[s]) continue;
+        path.assign(1, s);
+        next.assign(1, g.offset[s]);
+        onPath[s] = 1;
+        while (!path.empty() && budget > 0) {
+            if ((int)path.size() == k) return true;
+            int v = path.back();
+            if (next.back() == g.offset[v + 1]) {
+                onPath[v] = 0;
+                path.pop_back();
+                next.pop_back();
+                continue;
+            }
+            int u = g.target[next.back()++];
+            if (onPath[u]) continue;
+            --budget;
+            onPath[u] = 1;
+            path.push_back(u);
+            next.push_back(g.offset[u]);
+        }
+        for (int v : path) onPath[v] = 0;
+    }
+    path.clear();
+    return false;
+}
+
+// Kodowanie kolorami (Alon, Yuster, Zwick) z ograniczoną liczbą prób: losowe pokolorowanie na
+// k kolorów i programowanie dynamiczne po warstwach - warstwa i to dla każdego wierzchołka
+// bitset zbiorów kolorów ścieżek różnokolorowych o i wierzchołkach kończących się w nim. Warstwa
+// liczona równolegle po wierzchołkach; przechowujemy dwie, a świadka odtwarzamy, licząc
+// poprzednie warstwy od nowa. Ustalona k-ścieżka jest różnokolorowa z prawdopodobieństwem k!/k^k,
+// więc przy wielu ścieżkach wystarcza kilka prób; NotFound znaczy tylko "nie trafiono".
+// Pamięć: 2 * |vertices| * 2^k bitów - przy braku miejsca od razu NotFound
+inline SolveStatus kPathColorCoding(const CsrView& g, int k, const vector<int>& vertices, long long trials,
+                                    vector<int>& path, unsigned threads, SearchControl* control, unsigned seed) {
+    vector<int> index(g.n, -1);
+    for (size_t j = 0; j < vertices.size(); ++j) index[vertices[j]] = (int)j;
+    int words = k >= 6 ? 1 << (k - 6) : 1;
+    long long cells = (long long)vertices.size() * words;
+    if (cells > (1LL << 28)) return SolveStatus::NotFound;
+
+    vector<uint64_t> previous((size_t)cells), current((size_t)cells);
+    vector<int> color(g.n);
+    bool stopped = false;
+    // Warstwa 1: zbiór {kolor v}; warstwy 2..last przez rozszerzanie zbiorów sąsiadów
+    auto layers = [&](int last) {
+        fill(current.begin(), current.end(), 0);
+        for (size_t j = 0; j < vertices.size(); ++j) {
+            int single = 1 << color[vertices[j]];
+            current[j * words + single / 64] = 1ULL << (single % 64);
+        }
+        for (int layer = 2; layer <= last; ++layer) {
+            if (control && control->expired()) {
+                stopped = control->stopped = true;
+                return;
+            }
+            previous.swap(current);
+            parallelFor(0, (long long)vertices.size(), threads, [&](long long lo, long long hi) {
+                for (long long j = lo; j < hi; ++j) {
+                    int v = vertices[(size_t)j];
+                    uint64_t* out = &current[(size_t)j * words];
+                    fill(out, out + words, 0);
+                    for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i)
+                        extendByColor(&previous[(size_t)index[g.target[i]] * words], out, words, color[v]);
+                }
+            }, 1024);
+        }
+    };
+
+    mt19937 gen(seed);
+    uniform_int_distribution<int> pick(0, k - 1);
+    for (long long t = 0; t < trials; ++t) {
+        for (int& c : color) c = pick(gen);
+        layers(k);
+        if (stopped) return SolveStatus::Aborted;
+        int full = (1 << k) - 1, end = -1;
+        for (size_t j = 0; j < vertices.size() && end < 0; ++j)
+            if ((current[j * words + full / 64] >> (full % 64)) & 1) end = vertices[j];
+        if (end < 0) continue;
+
+        // Odtwarzanie: sąsiad, który w warstwie i - 1 miał zbiór S bez koloru bieżącego wierzchołka
+        int set = full, v = end;
+        path.push_back(v);
+        for (int layer = k - 1; layer >= 1; --layer) {
+            set &= ~(1 << color[v]);
+            layers(layer);
+            if (stopped) {
+                path.clear();
+                return SolveStatus::Aborted;
+            }
+            for (long long i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+                int u = g.target[i];
+                if ((current[(size_t)index[u] * words + set / 64] >> (set % 64)) & 1) {
+                    v = u;
+                    break;
+                }
+            }
+            path.push_back(v);
+        }
+        return SolveStatus::Found;
+    }
+    return SolveStatus::NotFound;
+}
+
+// Ścieżka prosta o k wierzchołkach (świadek w path). Najpierw odpadają składowe mniejsze niż k,
+// potem DFS z limitem dfsBudget i colorTrials prób kodowania kolorami - obie trafiają szybko, gdy
+// ścieżek jest dużo. Rozstrzyga sito wąskie: 2^k ewaluacji po O(k (n + m)) zamiast 3 k^k/k!
+// prób kolorowania (dla k = 20 to 10^6 wobec 1.3 * 10^8). Świadka daje zawężanie: blok
+// wierzchołków (połowa, ćwiartka, ...) odpada, gdy bez niego sito dalej widzi k-ścieżkę. Pomyłka
+// sita najwyżej zostawia blok, więc przy k wierzchołkach zostaje dokładnie ścieżka Hamiltona
+// podgrafu, a ją znajduje csrHamilton z dodatkowym wierzchołkiem połączonym ze wszystkimi. To
+// O(k log n) wywołań sita na coraz mniejszych podgrafach. Przy k > 30 od razu Aborted
+inline SolveStatus kPath(const CsrView& g, int k, vector<int>& path, unsigned threads = 0, long long colorTrials = 64,
+                         SearchControl* control = nullptr, long long dfsBudget = 1 << 20, unsigned seed = 1) {
+    path.clear();
+    if (k <= 0) return SolveStatus::Found;
+    if (k > g.n) return SolveStatus::NotFound;
+    if (k == g.n && TinyHamiltonTables::current().covers(g.n) &&
+        !TinyHamiltonTables::current().hasPath(g.n, tinyGraphMask(g)))
+        return SolveStatus::NotFound;
+
+    vector<int> labels = connectedComponents(g, threads), size(g.n, 0);
+    for (int v = 0; v < g.n; ++v) ++size[labels[v]];
+    vector<char> eligible(g.n, 0);
+    vector<int> keep;
+    for (int v = 0; v < g.n; ++v)
+        if (size[labels[v]] >= k) {
+            eligible[v] = 1;
+            keep.push_back(v);
+        }
+    if (keep.empty()) return SolveStatus::NotFound;
+    if (kPathDfs(g, k, eligible, path, dfsBudget)) return SolveStatus::Found;
+    if (k == 1) {
+        path.assign(1, keep[0]);
+        return SolveStatus::Found;
+    }
+    if (k > 30) return SolveStatus::Aborted;
+    SolveStatus s = kPathColorCoding(g, k, keep, colorTrials, path, threads, control, seed);
+    if (s != SolveStatus::NotFound) return s;
+
+    mt19937_64 gen(seed);
+    s = kPathSieve(inducedCsr(g, keep).view(), k, threads, control, gen);
+    if (s != SolveStatus::Found) return s;
+    for (size_t block = (keep.size() + 1) / 2; keep.size() > (size_t)k; block = (block + 1) / 2) {
+        for (size_t at = 0; at < keep.size() && keep.size() > (size_t)k;) {
+            size_t last = min(at + block, keep.size());
+            if (keep.size() - (last - at) < (size_t)k) {
+                at = last;
+                continue;
+            }
+            vector<int> rest(keep.begin(), keep.begin() + at);
+            rest.insert(rest.end(), keep.begin() + last, keep.end());
+            s = kPathSieve(inducedCsr(g, rest).view(), k, threads, control, gen);
+            if (s == SolveStatus::Aborted) return s;
+            if (s == SolveStatus::Found) keep.swap(rest);
+            else at = last;
+        }
+        if (block == 1) break;
+    }
+
+    // Ścieżka Hamiltona na keep to cykl przez wierzchołek apex; przy nadmiarowym keep (pomyłka
+    // sita) wystarczy pierwszych k wierzchołków takiej ścieżki
+    int apex = (int)keep.size();
+    vector<int> cycle;
+    s = csrHamilton(inducedCsr(g, keep, true).view(), cycle, control);
+    if (s == SolveStatus::Aborted) return s;
+    if (s == SolveStatus::Found) {
+        if (cycle.size() > 1 && cycle.front() == cycle.back()) cycle.pop_back();
+        rotate(cycle.begin(), find(cycle.begin(), cycle.end(), apex), cycle.end());
+        for (int j = 1; j <= k; ++j) path.push_back(keep[cycle[j]]);
+        return SolveStatus::Found;
+    }
+    vector<char> all(g.n, 1);
+    if (kPathDfs(g, k, all, path, INT64_MAX)) return SolveStatus::Found;
+    return SolveStatus::NotFound;
+}
+
+// Sprawdzanie certyfikatów w czasie O(V+E), niezależnie od algorytmu, który je wyprodukował
+
+// Cykl Eulera: każda krawędź dokładnie raz, kolejne wierzchołki sąsiednie, cykl zamknięty
+inline bool verifyEulerCycle(const Graph& g, const vector<int>& cycle) {
+    long long m = g.edgeCount();
+    if (m == 0) return cycle.size() <= 1;
+    if ((long long)cycle.size() != m + 1 || cycle.front() != cycle.back()) return false;
+
+    // Krotności krawędzi (każda krawędź występuje w listach dwa razy)
+    unordered_map<long long, int> left;
+    left.reserve((size_t)m * 2);
+    for (int u = 0; u < g.n; ++u)
+        for (int v : g.adj[u])
+            ++left[(long long)min(u, v) * g.n + max(u, v)];
+
+    for (size_t i = 0; i + 1 < cycle.size(); ++i) {
+        int a = cycle[i], b = cycle[i + 1];
+        if (a < 0 || a >= g.n || b < 0 || b >= g.n) return false;
+        auto it = left.find((long long)min(a, b) * g.n + max(a, b));
+        if (it == left.end() || it->second < 2) return false;
+        it->second -= 2;
+    }
+    return true;
+}
+
+// To samo sprawdzenie wprost na CSR - dla grafów, dla których Graph z macierzą n² jest za duży
+inline bool verifyEulerCycle(const CsrView& g, const vector<int>& cycle) {
+    if (g.m == 0) return cycle.size() <= 1;
+    if ((long long)cycle.size() != g.m + 1 || cycle.front() != cycle.back()) return false;
+    unordered_map<long long, int> left;
+    left.reserve((size_t)g.m * 2);
+    for (int u = 0; u < g.n; ++u)
+        for (long long i = g.offset[u]; i < g.offset[u + 1]; ++i)
+            ++left[(long long)min(u, g.target[i]) * g.n + max(u, g.target[i])];
+
+    for (size_t i = 0; i + 1 < cycle.size(); ++i) {
+        int a = cycle[i], b = cycle[i + 1];
+        if (a < 0 || a >= g.n || b < 0 || b >= g.n) return false;
+        auto it = left.find((long long)min(a, b) * g.n + max(a, b));
+        if (it == left.end() || it->second < 2) return false;
+        it->second -= 2;
+    }
+    return true;
+}
+
+// Cykl Hamiltona: permutacja wszystkich wierzchołków, zamknięta krawędzią do początku
+inline bool verifyHamiltonCycle(const Graph& g, const vector<int>& cycle) {
+    if ((int)cycle.size() != g.n + 1 || cycle.front() != cycle.back()) return false;
+    vector<bool> seen(g.n, false);
+    for (int i = 0; i < g.n; ++i) {
+        int v = cycle[i];
+        if (v < 0 || v >= g.n || seen[v]) return false;
+        seen[v] = true;
+    }
+    // Każdy wierzchołek jest początkiem dokładnie jednego kroku, więc skanowanie list kosztuje O(E)
+    for (int i = 0; i < g.n; ++i) {
+        int a = cycle[i], b = cycle[i + 1];
+        bool found = false;
+        for (int u : g.adj[a])
+            if (u == b) { found = true; break; }
+        if (!found) return false;
+    }
+    return true;
+}
+
+inline bool verifyHamiltonCycle(const CsrView& g, const vector<int>& cycle) {
+    if ((int)cycle.size() != g.n + 1 || cycle.front() != cycle.back()) return false;
+    vector<char> seen(g.n, 0);
+    for (int i = 0; i < g.n; ++i) {
+        int v = cycle[i];
+        if (v < 0 || v >= g.n || seen[v]) return false;
+        seen[v] = 1;
+    }
+    for (int i = 0; i < g.n; ++i) {
+        const int* begin = g.target + g.offset[cycle[i]];
+        const int* end = g.target + g.offset[cycle[i] + 1];
+        if (find(begin, end, cycle[i + 1]) == end) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Graf zmienny: krawędzie wstawiane i usuwane w O(1), migawki CSR budowane w tle
+// ---------------------------------------------------------------------------
+
+// Migawka tylko do odczytu; edgeIds[i] to numer w DynamicGraph krawędzi i z csr
+struct GraphSnapshot {
+    long long epoch = 0;  // liczba zmian grafu uwzględnionych w migawce
+    CsrGraph csr;
+    vector<int> edgeIds;
+};
+
+// Każdy wierzchołek ma tablicę slotów z numerami krawędzi (zapas rośnie jak w vector).
+// Usunięcie zostawia w obu slotach nagrobek -1, a tablicę wierzchołka zagęszczamy dopiero,
+// gdy nagrobki stanowią połowę - koszt zamortyzowany O(1). Numery usuniętych krawędzi wracają
+// do puli. Wątek w tle co interval buduje nową migawkę, jeśli od poprzedniej coś się zmieniło;
+// czytelnik trzyma shared_ptr do swojej migawki, więc stara epoka żyje, dopóki ktoś na niej liczy
+class DynamicGraph {
+public:
+    explicit DynamicGraph(int n = 0, milliseconds interval = milliseconds(100)) : slots(n), tombstones(n, 0) {
+        shared_ptr<GraphSnapshot> empty = make_shared<GraphSnapshot>();
+        empty->csr.n = n;
+        empty->csr.offset.assign((size_t)n + 1, 0);
+        current = empty;
+        if (interval.count() > 0) compactor = thread([this, interval] { compactLoop(interval); });
+    }
+
+    ~DynamicGraph() {
+        {
+            lock_guard<mutex> lk(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (compactor.joinable()) compactor.join();
+    }
+
+    int addVertex() {
+        lock_guard<mutex> lk(lock);
+        slots.emplace_back();
+        tombstones.push_back(0);
+        ++changes;
+        return (int)slots.size() - 1;
+    }
+
+    // Numer nowej krawędzi albo -1 dla złego wierzchołka
+    int addEdge(int u, int v) {
+        lock_guard<mutex> lk(lock);
+        if (u < 0 || v < 0 || u >= (int)slots.size() || v >= (int)slots.size()) return -1;
+        int id;
+        if (freeIds.empty()) {
+            id = (int)edges.size();
+            edges.emplace_back();
+        } else {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        Edge& e = edges[id];
+        e.u = u;
+        e.v = v;
+        e.slotU = (int)slots[u].size();
+        slots[u].push_back(id);
+        e.slotV = (int)slots[v].size();
+        slots[v].push_back(id);
+        ++live;
+        ++changes;
+        return id;
+    }
+
+    bool removeEdge(int id) {
+        lock_guard<mutex> lk(lock);
+        return erase(id);
+    }
+
+    // Pierwsza krawędź u-v (O(deg u)); false, gdy jej nie ma
+    bool removeEdge(int u, int v) {
+        lock_guard<mutex> lk(lock);
+        if (u < 0 || v < 0 || u >= (int)slots.size() || v >= (int)slots.size()) return false;
+        for (int id : slots[u])
+            if (id >= 0 && (edges[id].u == u ? edges[id].v : edges[id].u) == v) return erase(id);
+        return false;
+    }
+
+    int vertexCount() const {
+        lock_guard<mutex> lk(lock);
+        return (int)slots.size();
+    }
+
+    long long edgeCount() const {
+        lock_guard<mutex> lk(lock);
+        return live;
+    }
+
+    int degree(int v) const {
+        lock_guard<mutex> lk(lock);
+        return (int)slots[v].size() - tombstones[v];
+    }
+
+    long long version() const {
+        lock_guard<mutex> lk(lock);
+        return changes;
+    }
+
+    // Najnowsza opublikowana migawka (może być o kilka zmian starsza niż graf)
+    shared_ptr<const GraphSnapshot> snapshot() const {
+        lock_guard<mutex> lk(snapshotLock);
+        return current;
+    }
+
+    // Buduje i publikuje migawkę od razu. Pod blokadą kopiowane są tylko końce żywych krawędzi,
+    // CSR powstaje już bez niej, więc zapisy idą dalej
+    shared_ptr<const GraphSnapshot> compact() {
+        shared_ptr<GraphSnapshot> next = make_shared<GraphSnapshot>();
+        vector<pair<int, int>> ends;
+        int n;
+        {
+            lock_guard<mutex> lk(lock);
+            n = (int)slots.size();
+            next->epoch = changes;
+            ends.reserve((size_t)live);
+            next->edgeIds.reserve((size_t)live);
+            for (int id = 0; id < (int)edges.size(); ++id)
+                if (edges[id].slotU >= 0) {
+                    ends.push_back({ edges[id].u, edges[id].v });
+                    next->edgeIds.push_back(id);
+                }
+        }
+        next->csr = CsrGraph::fromEdges(n, ends);
+        lock_guard<mutex> lk(snapshotLock);
+        if (next->epoch > current->epoch) current = next;
+        return current;
+    }
+
+private:
+    struct Edge {
+        int u = 0, v = 0;
+        int slotU = -1, slotV = -1;  // -1: numer wolny
+    };
+
+    // Usunięcie pod blokadą: nagrobki w obu slotach, numer wraca do puli
+    bool erase(int id) {
+        if (id < 0 || id >= (int)edges.size() || edges[id].slotU < 0) return false;
+        Edge& e = edges[id];
+        slots[e.u][e.slotU] = -1;
+        slots[e.v][e.slotV] = -1;
+        ++tombstones[e.u];
+        ++tombstones[e.v];
+        int u = e.u, v = e.v;
+        e.slotU = e.slotV = -1;
+        freeIds.push_back(id);
+        --live;
+        ++changes;
+        squeeze(u);
+        if (v != u) squeeze(v);
+        return true;
+    }
+
+    // Zagęszczenie tablicy slotów wierzchołka, gdy połowa to nagrobki
+    void squeeze(int v) {
+        vector<int>& row = slots[v];
+        if (tombstones[v] * 2 < (int)row.size()) return;
+        int kept = 0;
+        for (int i = 0; i < (int)row.size(); ++i) {
+            int id = row[i];
+            if (id < 0) continue;
+            Edge& e = edges[id];
+            if (e.u == v && e.slotU == i) e.slotU = kept;
+            else e.slotV = kept;
+            row[kept++] = id;
+        }
+        row.resize(kept);
+        tombstones[v] = 0;
+    }
+
+    void compactLoop(milliseconds interval) {
+        unique_lock<mutex> lk(lock);
+        while (!stopping) {
+            wake.wait_for(lk, interval, [this] { return stopping; });
+            if (stopping || changes == snapshot()->epoch) continue;
+            lk.unlock();
+            compact();
+            lk.lock();
+        }
+    }
+
+    vector<vector<int>> slots;
+    vector<int> tombstones;
+    vector<Edge> edges;
+    vector<int> freeIds;
+    long long live = 0, changes = 0;
+    mutable mutex lock, snapshotLock;
+    shared_ptr<const GraphSnapshot> current;
+    condition_variable wake;
+    bool stopping = false;
+    thread compactor;
+};
@@ -0,0 +1,137 @@
+﻿#include "GraphApi.h"
+#include "Graph.h"
+
+#include <new>
+
+// Uchwyt trzyma własny CSR albo tylko widok na tablice wywołującego
+struct graph_t {
+    CsrGraph owned;
+    CsrView view;
+    // Dla przeszukiwania Hamiltona; budowane przy pierwszym zapytaniu, potem współdzielone
+    mutable once_flag adjacencyBuilt;
+    mutable unique_ptr<HybridAdjacency> adjacency;
+};
+
+namespace {
+
+// Wyjątki nie mogą przejść przez granicę C ABI
+template <class F>
+graph_status guarded(F body) {
+    try {
+        return body();
+    } catch (const bad_alloc&) {
+        return GRAPH_OUT_OF_MEMORY;
+    } catch (...) {
+        return GRAPH_INVALID_ARGUMENT;
+    }
+}
+
+}
+
+extern "C" {
+
+uint32_t graph_api_version(void) {
+    return GRAPH_API_VERSION;
+}
+
+graph_status graph_create_from_edges(int32_t n, const int32_t* edges, int64_t edge_count, graph_t** out) {
+    if (!out || n < 0 || edge_count < 0 || (edge_count > 0 && !edges)) return GRAPH_INVALID_ARGUMENT;
+    for (int64_t i = 0; i < 2 * edge_count; ++i)
+        if (edges[i] < 0 || edges[i] >= n) return GRAPH_INVALID_ARGUMENT;
+    return guarded([&] {
+        unique_ptr<graph_t> g(new graph_t());
+        g->owned = CsrGraph::fromEdges(n, edges, edge_count);
+        g->view = g->owned.view();
+        *out = g.release();
+        return GRAPH_OK;
+    });
+}
+
+graph_status graph_wrap_csr(int32_t n, int64_t edge_count, const int64_t* offset, const int32_t* target,
+                            const int32_t* edge_id, graph_t** out) {
+    if (!out || n < 0 || edge_count < 0 || !offset || (edge_count > 0 && (!target || !edge_id)))
+        return GRAPH_INVALID_ARGUMENT;
+    CsrView view;
+    view.n = n;
+    view.m = edge_count;
+    view.offset = reinterpret_cast<const long long*>(offset);
+    view.target = target;
+    view.edgeId = edge_id;
+    if (!csrValid(view)) return GRAPH_INVALID_ARGUMENT;
+    return graph_wrap_csr_unchecked(n, edge_count, offset, target, edge_id, out);
+}
+
+graph_status graph_wrap_csr_unchecked(int32_t n, int64_t edge_count, const int64_t* offset, const int32_t* target,
+                                      const int32_t* edge_id, graph_t** out) {
+    if (!out || n < 0 || edge_count < 0 || !offset || (edge_count > 0 && (!target || !edge_id)))
+        return GRAPH_INVALID_ARGUMENT;
+    return guarded([&] {
+        graph_t* g = new graph_t();
+        g->view.n = n;
+        g->view.m = edge_count;
+        g->view.offset = reinterpret_cast<const long long*>(offset);
+        g->view.target = target;
+        g->view.edgeId = edge_id;
+        *out = g;
+        return GRAPH_OK;
+    });
+}
+
+void graph_destroy(graph_t* graph) {
+    delete graph;
+}
+
+int32_t graph_vertex_count(const graph_t* graph) {
+    return graph ? graph->view.n : 0;
+}
+
+int64_t graph_edge_count(const graph_t* graph) {
+    return graph ? graph->view.m : 0;
+}
+
+int graph_is_eulerian(const graph_t* graph, uint32_t threads) {
+    return graph && csrIsEulerian(graph->view, threads) ? 1 : 0;
+}
+
+graph_status graph_euler_cycle(const graph_t* graph, int32_t start, int32_t* out, int64_t capacity,
+                               int64_t* length) {
+    if (!graph || !length || start < 0 || start >= graph->view.n) return GRAPH_INVALID_ARGUMENT;
+    *length = graph->view.m + 1;
+    if (!out || capacity < *length) return GRAPH_BUFFER_TOO_SMALL;
+    return guarded([&] {
+        *length = csrEulerInto(graph->view, start, out);
+        // Nieparzyste stopnie, niespójne krawędzie albo izolowany start: w out jest tylko szlak częściowy
+        return *length == graph->view.m + 1 && csrIsEulerian(graph->view, 1) ? GRAPH_OK : GRAPH_NOT_FOUND;
+    });
+}
+
+graph_status graph_hamilton_cycle(const graph_t* graph, uint32_t timeout_ms, int32_t* out, int64_t capacity,
+                                  int64_t* length) {
+    if (!graph || !length) return GRAPH_INVALID_ARGUMENT;
+    *length = (int64_t)graph->view.n + 1;
+    if (!out || capacity < *length) return GRAPH_BUFFER_TOO_SMALL;
+    return guarded([&] {
+        SearchControl control;
+        if (timeout_ms) control.deadline = steady_clock::now() + milliseconds(timeout_ms);
+        vector<int> path;
+        call_once(graph->adjacencyBuilt, [graph] { graph->adjacency = hamiltonAdjacency(graph->view); });
+        SolveStatus s = classifiedHamilton(graph->view, path, &control, graph->adjacency.get());
+        *length = (int64_t)path.size();
+        copy(path.begin(), path.end(), out);
+        return s == SolveStatus::Found ? GRAPH_OK : s == SolveStatus::Aborted ? GRAPH_ABORTED : GRAPH_NOT_FOUND;
+    });
+}
+
+graph_status graph_connected_components(const graph_t* graph, uint32_t threads, int32_t* labels,
+                                        int64_t capacity, int32_t* component_count) {
+    if (!graph) return GRAPH_INVALID_ARGUMENT;
+    if (!labels || capacity < graph->view.n) return GRAPH_BUFFER_TOO_SMALL;
+    return guarded([&] {
+        vector<int> result = connectedComponents(graph->view, threads);
+        copy(result.begin(), result.end(), labels);
+        if (component_count) *component_count = componentCount(result);
+        return GRAPH_OK;
+    });
+}
+
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+
+/* Stabilne C ABI biblioteki GraphLib. Graf jest nieprzezroczystym uchwytem, wejścia i wyjścia
+   to bufory wywołującego (wskaźnik + długość), więc nic nie jest kopiowane na granicy wywołania. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#ifdef GRAPHLIB_EXPORTS
+#define GRAPH_API __declspec(dllexport)
+#else
+#define GRAPH_API __declspec(dllimport)
+#endif
+#else
+#define GRAPH_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GRAPH_API_VERSION 2
+
+typedef struct graph_t graph_t;
+
+typedef enum graph_status {
+    GRAPH_OK = 0,
+    GRAPH_NOT_FOUND = 1,         /* graf nie ma szukanego cyklu */
+    GRAPH_ABORTED = 2,           /* przekroczony limit czasu */
+    GRAPH_INVALID_ARGUMENT = 3,
+    GRAPH_BUFFER_TOO_SMALL = 4,  /* wymagana długość w *length */
+    GRAPH_OUT_OF_MEMORY = 5
+} graph_status;
+
+GRAPH_API uint32_t graph_api_version(void);
+
+/* Krawędzie jako płaska tablica par int32 (u0, v0, u1, v1, ...) długości 2 * edge_count */
+GRAPH_API graph_status graph_create_from_edges(int32_t n, const int32_t* edges, int64_t edge_count,
+                                               graph_t** out);
+
+/* Gotowy CSR wywołującego bez kopiowania: offset[n + 1], target[2m], edge_id[2m].
+   Tablice muszą żyć dłużej niż uchwyt. Sprawdzane w O(n + m): offset[0] = 0, offset[n] = 2m,
+   offsety niemalejące, target w [0, n), edge_id w [0, m); inaczej GRAPH_INVALID_ARGUMENT */
+GRAPH_API graph_status graph_wrap_csr(int32_t n, int64_t edge_count, const int64_t* offset,
+                                      const int32_t* target, const int32_t* edge_id, graph_t** out);
+
+/* Jak graph_wrap_csr, ale bez sprawdzania zawartości tablic (dla CSR już sprawdzonego, np.
+   z własnego generatora). Niepoprawne tablice to niezdefiniowane zachowanie */
+GRAPH_API graph_status graph_wrap_csr_unchecked(int32_t n, int64_t edge_count, const int64_t* offset,
+                                                const int32_t* target, const int32_t* edge_id, graph_t** out);
+
+GRAPH_API void graph_destroy(graph_t* graph);
+
+GRAPH_API int32_t graph_vertex_count(const graph_t* graph);
+GRAPH_API int64_t graph_edge_count(const graph_t* graph);
+GRAPH_API int graph_is_eulerian(const graph_t* graph, uint32_t threads);
+
+/* Cykl Eulera od wierzchołka start; out musi mieć co najmniej edge_count + 1 miejsc.
+   GRAPH_NOT_FOUND, gdy graf nie jest eulerowski albo start nie leży na krawędziach - wtedy
+   w out (długość w *length) jest szlak od start, który nie przechodzi wszystkich krawędzi */
+GRAPH_API graph_status graph_euler_cycle(const graph_t* graph, int32_t start, int32_t* out, int64_t capacity,
+                                         int64_t* length);
+
+/* Cykl Hamiltona (n + 1 wierzchołków, pierwszy = ostatni); timeout_ms = 0 oznacza brak limitu */
+GRAPH_API graph_status graph_hamilton_cycle(const graph_t* graph, uint32_t timeout_ms, int32_t* out,
+                                            int64_t capacity, int64_t* length);
+
+/* Etykiety składowych spójności do labels (capacity miejsc, potrzeba n, inaczej
+   GRAPH_BUFFER_TOO_SMALL i nic nie jest zapisywane); threads = 0 oznacza wszystkie rdzenie */
+GRAPH_API graph_status graph_connected_components(const graph_t* graph, uint32_t threads, int32_t* labels,
+                                                  int64_t capacity, int32_t* component_count);
+
+#ifdef __cplusplus
+}
+#endif
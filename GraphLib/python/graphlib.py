@@ -0,0 +1,134 @@
+"""Wiązania Pythona do biblioteki GraphLib (C ABI z GraphApi.h).
+
+Tablice NumPy są przekazywane do biblioteki wskaźnikiem, bez kopiowania: krawędzie czytane są
+wprost z bufora wywołującego, a cykle zapisywane do tablic przydzielonych tutaj, które wracają
+do użytkownika jako zwykłe ndarray (protokół bufora).
+
+Ścieżkę do biblioteki można podać w zmiennej środowiskowej GRAPHLIB_PATH.
+"""
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+OK, NOT_FOUND, ABORTED, INVALID_ARGUMENT, BUFFER_TOO_SMALL, OUT_OF_MEMORY = range(6)
+
+_int32_p = np.ctypeslib.ndpointer(dtype=np.int32, flags="C_CONTIGUOUS")
+_int64_p = np.ctypeslib.ndpointer(dtype=np.int64, flags="C_CONTIGUOUS")
+
+
+def _load():
+    path = os.environ.get("GRAPHLIB_PATH")
+    if not path:
+        name = "GraphLib.dll" if sys.platform == "win32" else "libGraphLib.so"
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+    lib = ctypes.CDLL(path)
+
+    handle = ctypes.c_void_p
+    lib.graph_api_version.restype = ctypes.c_uint32
+    lib.graph_create_from_edges.argtypes = [ctypes.c_int32, _int32_p, ctypes.c_int64, ctypes.POINTER(handle)]
+    lib.graph_wrap_csr.argtypes = [ctypes.c_int32, ctypes.c_int64, _int64_p, _int32_p, _int32_p,
+                                   ctypes.POINTER(handle)]
+    lib.graph_wrap_csr_unchecked.argtypes = lib.graph_wrap_csr.argtypes
+    lib.graph_destroy.argtypes = [handle]
+    lib.graph_destroy.restype = None
+    lib.graph_vertex_count.argtypes = [handle]
+    lib.graph_vertex_count.restype = ctypes.c_int32
+    lib.graph_edge_count.argtypes = [handle]
+    lib.graph_edge_count.restype = ctypes.c_int64
+    lib.graph_is_eulerian.argtypes = [handle, ctypes.c_uint32]
+    lib.graph_euler_cycle.argtypes = [handle, ctypes.c_int32, _int32_p, ctypes.c_int64,
+                                      ctypes.POINTER(ctypes.c_int64)]
+    lib.graph_hamilton_cycle.argtypes = [handle, ctypes.c_uint32, _int32_p, ctypes.c_int64,
+                                         ctypes.POINTER(ctypes.c_int64)]
+    lib.graph_connected_components.argtypes = [handle, ctypes.c_uint32, _int32_p, ctypes.c_int64,
+                                               ctypes.POINTER(ctypes.c_int32)]
+    if lib.graph_api_version() != 2:
+        raise RuntimeError("nieobsługiwana wersja GraphLib: %d" % lib.graph_api_version())
+    return lib
+
+
+_lib = _load()
+
+
+class GraphError(RuntimeError):
+    pass
+
+
+def _check(status):
+    if status not in (OK, NOT_FOUND, ABORTED):
+        raise GraphError("GraphLib zwróciła kod %d" % status)
+    return status
+
+
+class Graph:
+    """Nieprzezroczysty uchwyt grafu. Graf tworzony przez from_csr trzyma referencje do tablic."""
+
+    def __init__(self, handle, keep_alive=()):
+        self._handle = handle
+        self._keep_alive = keep_alive
+
+    @classmethod
+    def from_edges(cls, n, edges):
+        """edges: tablica (m, 2) albo płaska parzystej długości; int32 w układzie C nie jest kopiowana."""
+        edges = np.ascontiguousarray(edges, dtype=np.int32)
+        if not (edges.ndim == 2 and edges.shape[1] == 2) and not (edges.ndim == 1 and len(edges) % 2 == 0):
+            raise ValueError("edges musi mieć kształt (m, 2) albo parzystą długość, jest %s" % (edges.shape,))
+        edges = edges.reshape(-1)
+        handle = ctypes.c_void_p()
+        _check(_lib.graph_create_from_edges(n, edges, len(edges) // 2, ctypes.byref(handle)))
+        return cls(handle)
+
+    @classmethod
+    def from_csr(cls, offset, target, edge_id, checked=True):
+        """Widok na gotowy CSR bez kopiowania; tablice żyją co najmniej tak długo jak graf.
+        checked=False pomija sprawdzenie zakresów (tylko dla CSR pewnego pochodzenia)."""
+        offset = np.ascontiguousarray(offset, dtype=np.int64)
+        target = np.ascontiguousarray(target, dtype=np.int32)
+        edge_id = np.ascontiguousarray(edge_id, dtype=np.int32)
+        handle = ctypes.c_void_p()
+        wrap = _lib.graph_wrap_csr if checked else _lib.graph_wrap_csr_unchecked
+        _check(wrap(len(offset) - 1, len(target) // 2, offset, target, edge_id, ctypes.byref(handle)))
+        return cls(handle, (offset, target, edge_id))
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            _lib.graph_destroy(self._handle)
+            self._handle = None
+
+    @property
+    def n(self):
+        return _lib.graph_vertex_count(self._handle)
+
+    @property
+    def m(self):
+        return _lib.graph_edge_count(self._handle)
+
+    def is_eulerian(self, threads=0):
+        return bool(_lib.graph_is_eulerian(self._handle, threads))
+
+    def euler_cycle(self, start=0):
+        """Ciąg wierzchołków cyklu Eulera od start, None gdy graf nie jest eulerowski
+        (albo start nie leży na żadnej krawędzi)."""
+        out = np.empty(self.m + 1, dtype=np.int32)
+        length = ctypes.c_int64()
+        status = _check(_lib.graph_euler_cycle(self._handle, start, out, len(out), ctypes.byref(length)))
+        return out[:length.value] if status == OK else None
+
+    def hamilton_cycle(self, timeout_ms=0):
+        """Cykl Hamiltona jako ndarray, None gdy go nie ma; TimeoutError po przekroczeniu limitu."""
+        out = np.empty(self.n + 1, dtype=np.int32)
+        length = ctypes.c_int64()
+        status = _check(_lib.graph_hamilton_cycle(self._handle, timeout_ms, out, len(out), ctypes.byref(length)))
+        if status == ABORTED:
+            raise TimeoutError("przekroczony limit czasu wyszukiwania cyklu Hamiltona")
+        return out[:length.value] if status == OK else None
+
+    def connected_components(self, threads=0):
+        """(etykiety, liczba składowych)"""
+        labels = np.empty(self.n, dtype=np.int32)
+        count = ctypes.c_int32()
+        _check(_lib.graph_connected_components(self._handle, threads, labels, len(labels), ctypes.byref(count)))
+        return labels, count.value